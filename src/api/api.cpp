@@ -0,0 +1,103 @@
+#include "api.h"
+
+#include <sys/mman.h>
+#include <unistd.h>
+#include <mutex>
+
+#include "../db/db.h"
+#include "../global.h"
+#include "../io/io.h"
+#include "../sta/sta.h"
+
+namespace {
+//  the database, the library and the options are process-wide
+std::mutex extractMtx;
+
+//  The path of an input, that of an anonymous memory file holding it when given by its contents
+class InputPath {
+private:
+    int _fd = -1;
+    string _path;
+
+public:
+    InputPath() {}
+    InputPath(const InputPath&) = delete;
+    InputPath& operator=(const InputPath&) = delete;
+    ~InputPath() {
+        if (_fd >= 0) close(_fd);
+    }
+
+    bool open(const api::Input& input, const char* name) {
+        if (input.data.empty()) {
+            _path = input.path;
+            return true;
+        }
+        _fd = memfd_create(name, MFD_CLOEXEC);
+        for (size_t written = 0; _fd >= 0 && written != input.data.size();) {
+            const ssize_t n = write(_fd, input.data.data() + written, input.data.size() - written);
+            if (n < 0 && errno != EINTR) {
+                close(_fd);
+                _fd = -1;
+            }
+            if (n > 0) written += n;
+        }
+        if (_fd < 0) {
+            printlog(LOG_ERROR, "cannot keep %s in memory", name);
+            return false;
+        }
+        _path = "/proc/self/fd/" + to_string(_fd);
+        return true;
+    }
+
+    const string& path() const { return _path; }
+};
+}  // namespace
+
+api::Result api::extract(const Options& options) {
+    lock_guard<mutex> lock(extractMtx);
+    Result result;
+
+    InputPath techLef, cellLef, def, liberty, netDetail, timePath, timeUnconstrain;
+    if (!techLef.open(options.techLef, "tech_lef") || !cellLef.open(options.cellLef, "cell_lef") ||
+        !def.open(options.def, "def") || !liberty.open(options.liberty, "liberty") ||
+        !netDetail.open(options.netDetail, "net_detail") || !timePath.open(options.timePath, "time_path") ||
+        !timeUnconstrain.open(options.timeUnconstrain, "time_unconstrain")) {
+        return result;
+    }
+
+    //  what an earlier extraction left
+    database.clear();
+    rlib = sta::STALibrary();
+    io::IOModule::forgetDirs();
+
+    io::IOModule::LefTech = techLef.path();
+    io::IOModule::LefCell = cellLef.path();
+    io::IOModule::DefCell = def.path();
+    io::IOModule::Liberty = liberty.path();
+    io::IOModule::LibertyCache = options.libertyCache;
+    io::IOModule::NetDetail = netDetail.path();
+    io::IOModule::TimePath = timePath.path();
+    io::IOModule::TimeUnconstrain = timeUnconstrain.path();
+    io::IOModule::Columns = options.columns;
+    io::IOModule::Columnar = options.columnar;
+    io::IOModule::GraphTables = options.graphTables;
+    io::IOModule::ImageDir = options.imageDir;
+    io::IOModule::ImageShards = options.imageShards;
+    db::DBModule::Metal = options.metal;
+    db::DBModule::NumCands = options.numCands;
+
+    const string dir = options.outputDir.empty() ? "." : options.outputDir;
+    io::IOModule::DefPlacement = dir + "/" + options.design + "_M" + to_string(options.metal) + ".csv";
+    map<string, string> files;
+    io::IOModule::Capture = options.outputDir.empty() ? &files : nullptr;
+
+    result.ok = io::IOModule::load() && db::DBModule::setup();
+    io::IOModule::Capture = nullptr;
+
+    //  relative to the directory of the outputs
+    const string prefix = io::IOModule::outputDir(io::IOModule::DefPlacement) + "/";
+    for (auto& [file, data] : files) {
+        result.files.emplace(file.compare(0, prefix.size(), prefix) ? file : file.substr(prefix.size()), move(data));
+    }
+    return result;
+}
@@ -0,0 +1,71 @@
+#ifndef _API_API_H_
+#define _API_API_H_
+
+#include <map>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace api {
+//  An input file, given by its path or by its contents
+struct Input {
+    std::string path;
+    std::string data;
+
+    Input() {}
+    Input(const char* path) : path(path) {}
+    Input(const std::string& path) : path(path) {}
+    static Input contents(std::string data) {
+        Input input;
+        input.data = std::move(data);
+        return input;
+    }
+
+    bool empty() const { return path.empty() && data.empty(); }
+};
+
+//  The inputs and options of an extraction, as the flags of the extract binary
+struct Options {
+    Input techLef;
+    Input cellLef;
+    Input def;
+    Input liberty;
+    Input netDetail;
+    Input timePath;
+    Input timeUnconstrain;
+
+    //  the outputs are named <design>_M<metal>
+    std::string design = "design";
+    unsigned metal = 3;
+    unsigned numCands = 31;
+    //  the columns of the driver, sink and arc tables, all of them when empty
+    std::vector<std::string> columns;
+    bool columnar = false;
+    bool graphTables = false;
+    unsigned imageShards = 0;
+    std::string imageDir;
+    std::string libertyCache;
+    //  the directory the outputs are written to, they are kept in the Result when empty
+    std::string outputDir;
+};
+
+//  The outputs of an extraction by their path relative to <outputDir>/<design>_M<metal>: the tables, the via
+//  patches as PNG and the manifest
+struct Result {
+    bool ok = false;
+    std::map<std::string, std::string> files;
+
+    //  empty when there is no such output
+    std::string_view file(const std::string& name) const {
+        const std::map<std::string, std::string>::const_iterator fi = files.find(name);
+        return fi == files.end() ? std::string_view() : std::string_view(fi->second);
+    }
+};
+
+//  Run a whole extraction in this process.
+//  The design and libraries live in process-wide state, so extractions run one at a time; each of them uses all the
+//  OpenMP threads.
+Result extract(const Options& options);
+}  // namespace api
+
+#endif
@@ -0,0 +1,107 @@
+#include "api_c.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <sstream>
+
+#include "../ut/log.h"
+#include "api.h"
+
+struct sx_options {
+    api::Options options;
+};
+
+struct sx_result {
+    api::Result result;
+    //  the entries of `result.files` by index
+    std::vector<const std::pair<const std::string, std::string>*> files;
+};
+
+namespace {
+api::Input* input(sx_options* options, const std::string& name) {
+    api::Options& o = options->options;
+    if (name == "tech_lef") return &o.techLef;
+    if (name == "cell_lef") return &o.cellLef;
+    if (name == "input_def") return &o.def;
+    if (name == "liberty") return &o.liberty;
+    if (name == "net_detail") return &o.netDetail;
+    if (name == "time_path") return &o.timePath;
+    if (name == "time_unconstrain") return &o.timeUnconstrain;
+    return nullptr;
+}
+}  // namespace
+
+sx_options* sx_options_new(void) { return new sx_options; }
+
+void sx_options_free(sx_options* options) { delete options; }
+
+int sx_options_set(sx_options* options, const char* name, const char* value) {
+    const std::string n = name;
+    const std::string v = value;
+    api::Options& o = options->options;
+    if (api::Input* in = input(options, n)) {
+        *in = api::Input(v);
+    } else if (n == "design") {
+        o.design = v;
+    } else if (n == "metal") {
+        o.metal = atoi(value);
+    } else if (n == "num_cands") {
+        o.numCands = atoi(value);
+    } else if (n == "columns") {
+        std::string names = v;
+        std::replace(names.begin(), names.end(), ',', ' ');
+        std::istringstream iss(names);
+        o.columns.clear();
+        for (std::string column; iss >> column;) o.columns.push_back(column);
+    } else if (n == "columnar") {
+        o.columnar = atoi(value);
+    } else if (n == "graph_tables") {
+        o.graphTables = atoi(value);
+    } else if (n == "image_shards") {
+        o.imageShards = atoi(value);
+    } else if (n == "image_dir") {
+        o.imageDir = v;
+    } else if (n == "liberty_cache") {
+        o.libertyCache = v;
+    } else if (n == "output_dir") {
+        o.outputDir = v;
+    } else {
+        return 0;
+    }
+    return 1;
+}
+
+int sx_options_set_data(sx_options* options, const char* name, const void* data, size_t size) {
+    api::Input* in = input(options, name);
+    if (!in) return 0;
+    *in = api::Input::contents(std::string(static_cast<const char*>(data), size));
+    return 1;
+}
+
+void sx_log_level(int level) { init_log(level); }
+
+sx_result* sx_extract(const sx_options* options) {
+    sx_result* result = new sx_result;
+    result->result = api::extract(options->options);
+    for (const auto& file : result->result.files) result->files.push_back(&file);
+    return result;
+}
+
+int sx_result_ok(const sx_result* result) { return result->result.ok; }
+
+size_t sx_result_count(const sx_result* result) { return result->files.size(); }
+
+const char* sx_result_name(const sx_result* result, size_t i) { return result->files[i]->first.c_str(); }
+
+const void* sx_result_data(const sx_result* result, size_t i, size_t* size) {
+    *size = result->files[i]->second.size();
+    return result->files[i]->second.data();
+}
+
+const void* sx_result_file(const sx_result* result, const char* name, size_t* size) {
+    const std::string_view data = result->result.file(name);
+    *size = data.size();
+    return data.data();
+}
+
+void sx_result_free(sx_result* result) { delete result; }
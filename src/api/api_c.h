@@ -0,0 +1,41 @@
+#ifndef _API_API_C_H_
+#define _API_API_C_H_
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+//  The C interface of api::extract.
+//  Options are set by the names of the flags of the extract binary: tech_lef, cell_lef, input_def, liberty,
+//  net_detail, time_path and time_unconstrain take paths, or contents with sx_options_set_data; design, metal,
+//  num_cands, columns, columnar, graph_tables, image_shards, image_dir, liberty_cache and output_dir take values.
+typedef struct sx_options sx_options;
+typedef struct sx_result sx_result;
+
+sx_options* sx_options_new(void);
+void sx_options_free(sx_options* options);
+//  0 for an unknown option
+int sx_options_set(sx_options* options, const char* name, const char* value);
+int sx_options_set_data(sx_options* options, const char* name, const void* data, size_t size);
+
+//  logs of the given level mask to stdout, none by default
+void sx_log_level(int level);
+
+//  never null, free with sx_result_free
+sx_result* sx_extract(const sx_options* options);
+int sx_result_ok(const sx_result* result);
+//  the outputs kept in memory, sorted by name
+size_t sx_result_count(const sx_result* result);
+const char* sx_result_name(const sx_result* result, size_t i);
+const void* sx_result_data(const sx_result* result, size_t i, size_t* size);
+//  null when there is no such output
+const void* sx_result_file(const sx_result* result, const char* name, size_t* size);
+void sx_result_free(sx_result* result);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,224 @@
+#include "server.h"
+
+#include <omp.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <unordered_set>
+
+#include "../db/db.h"
+#include "../global.h"
+#include "../io/io.h"
+
+namespace {
+//  the flags a job may set, the library ones are the server's
+const unordered_set<string> JobFlags = {"input_def",
+                                        "output_csv",
+                                        "metal",
+                                        "num_cands",
+                                        "net_detail",
+                                        "time_path",
+                                        "time_unconstrain",
+                                        "columns",
+                                        "columnar",
+                                        "graph_tables",
+                                        "image_dir",
+                                        "image_shards"};
+
+//  A connection sending its job
+struct Client {
+    int fd;
+    string buffer;
+};
+
+struct Job {
+    unsigned id;
+    int fd;
+    map<string, string> options;
+};
+
+bool reply(const int fd, const string& line) {
+    const string data = line + "\n";
+    for (size_t written = 0; written != data.size();) {
+        const ssize_t n = send(fd, data.data() + written, data.size() - written, MSG_NOSIGNAL);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            return false;
+        }
+        written += n;
+    }
+    return true;
+}
+
+//  the lines of `buffer` up to the empty one into `options`, false while it is yet to come
+bool readJob(const string& buffer, map<string, string>& options) {
+    options.clear();
+    for (size_t begin = 0, end; (end = buffer.find('\n', begin)) != string::npos; begin = end + 1) {
+        string line = buffer.substr(begin, end - begin);
+        if (line.size() && line.back() == '\r') line.pop_back();
+        if (line.empty()) return true;
+        const size_t flag = line.find_first_not_of('-');
+        const size_t space = line.find_first_of(" \t");
+        const size_t value = line.find_first_not_of(" \t", space);
+        if (flag == space) continue;
+        options[line.substr(flag, space == string::npos ? string::npos : space - flag)] =
+            value == string::npos ? "" : line.substr(value);
+    }
+    return false;
+}
+
+//  the reason to reject `options`, empty if none
+string checkJob(const map<string, string>& options) {
+    for (const auto& [flag, value] : options) {
+        if (!JobFlags.count(flag)) return "unknown flag " + flag;
+    }
+    for (const char* flag : {"input_def", "metal", "output_csv"}) {
+        if (!options.count(flag)) return string("missing flag ") + flag;
+    }
+    return "";
+}
+
+bool setOptions(const map<string, string>& options) {
+    for (const auto& [flag, value] : options) {
+        if (flag == "input_def") {
+            io::IOModule::DefCell = value;
+        } else if (flag == "output_csv") {
+            io::IOModule::DefPlacement = value;
+        } else if (flag == "metal") {
+            db::DBModule::Metal = atoi(value.c_str());
+        } else if (flag == "num_cands") {
+            db::DBModule::NumCands = atoi(value.c_str());
+        } else if (flag == "net_detail") {
+            io::IOModule::NetDetail = value;
+        } else if (flag == "time_path") {
+            io::IOModule::TimePath = value;
+        } else if (flag == "time_unconstrain") {
+            io::IOModule::TimeUnconstrain = value;
+        } else if (flag == "columns") {
+            if (!io::IOModule::selectColumns(value)) return false;
+        } else if (flag == "columnar") {
+            io::IOModule::Columnar = value != "0";
+        } else if (flag == "graph_tables") {
+            io::IOModule::GraphTables = value != "0";
+        } else if (flag == "image_dir") {
+            io::IOModule::ImageDir = value;
+        } else if (flag == "image_shards") {
+            io::IOModule::ImageShards = atoi(value.c_str());
+        }
+    }
+    return true;
+}
+
+//  in the forked worker, on top of the loaded library
+bool runJob(const Job& job) {
+    reply(job.fd, "running " + to_string(job.id));
+    bool ok = setOptions(job.options);
+    if (!ok) reply(job.fd, "error no columns in " + job.options.at("columns"));
+    ok = ok && database.readDEF(io::IOModule::DefCell) && db::DBModule::setup();
+    if (ok) {
+        const string dir = io::IOModule::outputDir(io::IOModule::DefPlacement);
+        reply(job.fd, "output " + dir);
+        reply(job.fd, "manifest " + dir + "/" + dir.substr(dir.find_last_of('/') + 1) + ".manifest");
+    }
+    reply(job.fd, "done " + to_string(job.id) + (ok ? " ok" : " failed"));
+    return ok;
+}
+}  // namespace
+
+bool api::serve(const string& path, const unsigned nWorkers) {
+    //  the OpenMP threads of the server would not survive the forks, so it loads on its own thread and leaves them
+    //  to the workers
+    const int nThreads = max(1, omp_get_max_threads() / static_cast<int>(max(nWorkers, 1u)));
+    omp_set_num_threads(1);
+    if (!io::IOModule::load()) return false;
+
+    sockaddr_un addr{};
+    addr.sun_family = AF_UNIX;
+    if (path.size() >= sizeof(addr.sun_path)) {
+        printlog(LOG_ERROR, "socket path too long: %s", path.c_str());
+        return false;
+    }
+    strcpy(addr.sun_path, path.c_str());
+    unlink(path.c_str());
+    const int listener = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (listener < 0 || bind(listener, reinterpret_cast<const sockaddr*>(&addr), sizeof(addr)) ||
+        listen(listener, SOMAXCONN)) {
+        printlog(LOG_ERROR, "cannot listen on %s", path.c_str());
+        return false;
+    }
+    printlog(LOG_INFO, "serving on %s with %u workers of %d threads", path.c_str(), nWorkers, nThreads);
+
+    vector<Client> clients;
+    deque<Job> jobs;
+    unordered_map<pid_t, unsigned> workers;
+    unsigned nJobs = 0;
+    while (true) {
+        int status = 0;
+        for (pid_t pid; (pid = waitpid(-1, &status, WNOHANG)) > 0;) {
+            const bool ok = WIFEXITED(status) && !WEXITSTATUS(status);
+            printlog(ok ? LOG_INFO : LOG_WARN, "job %u %s", workers[pid], ok ? "done" : "failed");
+            workers.erase(pid);
+        }
+        while (jobs.size() && workers.size() < max(nWorkers, 1u)) {
+            const Job& job = jobs.front();
+            const pid_t pid = fork();
+            if (!pid) {
+                close(listener);
+                for (const Client& client : clients) close(client.fd);
+                for (const Job& other : jobs) {
+                    if (&other != &job) close(other.fd);
+                }
+                omp_set_num_threads(nThreads);
+                _exit(runJob(job) ? 0 : 1);
+            }
+            if (pid < 0) {
+                reply(job.fd, "error cannot fork");
+            } else {
+                printlog(LOG_INFO, "job %u running %s", job.id, job.options.at("input_def").c_str());
+                workers.emplace(pid, job.id);
+            }
+            close(job.fd);
+            jobs.pop_front();
+        }
+
+        vector<pollfd> fds = {{listener, POLLIN, 0}};
+        for (const Client& client : clients) fds.push_back({client.fd, POLLIN, 0});
+        //  wake up now and then to reap the workers
+        if (poll(fds.data(), fds.size(), 100) < 0) {
+            if (errno == EINTR) continue;
+            printlog(LOG_ERROR, "cannot poll on %s", path.c_str());
+            return false;
+        }
+        if (fds[0].revents & POLLIN) {
+            const int fd = accept4(listener, nullptr, nullptr, SOCK_CLOEXEC);
+            if (fd >= 0) clients.push_back({fd, ""});
+        }
+        //  backwards, so that erasing a client keeps the indices of the others
+        for (unsigned i = fds.size() - 1; i; --i) {
+            if (!fds[i].revents) continue;
+            Client& client = clients[i - 1];
+            char buffer[4096];
+            const ssize_t n = read(client.fd, buffer, sizeof(buffer));
+            if (n < 0 && errno == EINTR) continue;
+            Job job{nJobs, client.fd, {}};
+            if (n > 0) {
+                client.buffer.append(buffer, n);
+                if (!readJob(client.buffer, job.options)) continue;
+                const string error = checkJob(job.options);
+                if (error.empty()) {
+                    reply(job.fd, "queued " + to_string(job.id));
+                    jobs.push_back(move(job));
+                    ++nJobs;
+                } else {
+                    reply(job.fd, "error " + error);
+                    close(job.fd);
+                }
+            } else {
+                close(client.fd);
+            }
+            clients.erase(clients.begin() + (i - 1));
+        }
+    }
+}
@@ -0,0 +1,22 @@
+#ifndef _API_SERVER_H_
+#define _API_SERVER_H_
+
+#include <string>
+
+namespace api {
+//  Load the technology, cells and timing library of the IOModule options, then serve extraction jobs on the
+//  UNIX-domain socket `path`; false if either fails.
+//  Each job runs in a process forked from the server, so that it starts from the loaded state and leaves it intact
+//  for the next ones; at most `nWorkers` run at a time and share the OpenMP threads.
+//  A client sends one job per connection, as lines of "<flag> <value>" with the flags of the extract binary for the
+//  design (input_def and output_csv are required) ended by an empty line. The server streams back lines of
+//      queued <job>
+//      running <job>
+//      output <directory of the outputs>
+//      manifest <file listing the outputs>
+//      done <job> ok|failed
+//  or "error <message>" for a job it rejects. A job that ends without "done" has crashed.
+bool serve(const std::string& path, const unsigned nWorkers);
+}  // namespace api
+
+#endif
@@ -0,0 +1,60 @@
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include <cstring>
+#include <iostream>
+#include <string>
+
+//  Send a job to `extract --serve` and print what the server streams back, exits with 0 once the job is done.
+//      extract_client <socket> --input_def <def> --metal <metal> --output_csv <csv> [--<flag> [<value>]]...
+//  a flag with no value, as --columnar, is set to 1
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        std::cerr << "usage: " << argv[0] << " <socket> --<flag> [<value>]..." << std::endl;
+        return 1;
+    }
+
+    std::string job;
+    for (int i = 2; i < argc; ++i) {
+        if (strncmp(argv[i], "--", 2)) {
+            std::cerr << "not a flag: " << argv[i] << std::endl;
+            return 1;
+        }
+        job += argv[i] + 2;
+        job += ' ';
+        job += i + 1 < argc && strncmp(argv[i + 1], "--", 2) ? argv[++i] : "1";
+        job += '\n';
+    }
+    job += '\n';
+
+    sockaddr_un addr{};
+    addr.sun_family = AF_UNIX;
+    strncpy(addr.sun_path, argv[1], sizeof(addr.sun_path) - 1);
+    const int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0 || connect(fd, reinterpret_cast<const sockaddr*>(&addr), sizeof(addr))) {
+        std::cerr << "cannot connect to " << argv[1] << std::endl;
+        return 1;
+    }
+    for (size_t written = 0; written != job.size();) {
+        const ssize_t n = write(fd, job.data() + written, job.size() - written);
+        if (n <= 0) {
+            std::cerr << "cannot send the job to " << argv[1] << std::endl;
+            return 1;
+        }
+        written += n;
+    }
+
+    std::string lines;
+    bool done = false;
+    char buffer[4096];
+    for (ssize_t n; (n = read(fd, buffer, sizeof(buffer))) > 0;) {
+        lines.append(buffer, n);
+        for (size_t end; (end = lines.find('\n')) != std::string::npos; lines.erase(0, end + 1)) {
+            const std::string line = lines.substr(0, end);
+            std::cout << line << std::endl;
+            if (!line.compare(0, 5, "done ")) done = line.size() > 3 && !line.compare(line.size() - 3, 3, " ok");
+        }
+    }
+    close(fd);
+    return done ? 0 : 1;
+}
@@ -32,8 +32,12 @@ void Database::clear() {
 void Database::clearTechnology() {
     CLEAR_POINTER_LIST(layers);
     CLEAR_POINTER_LIST(viatypes);
-    CLEAR_POINTER_LIST(layers);
     CLEAR_POINTER_MAP(ndrs);
+    name_viatypes.clear();
+    rLayers.clear();
+    cLayers.clear();
+    name_layers.clear();
+    nLayers = 0;
 }
 
 void Database::clearDesign() {
@@ -43,6 +47,17 @@ void Database::clearDesign() {
     CLEAR_POINTER_LIST(rows);
     CLEAR_POINTER_LIST(regions);
     CLEAR_POINTER_LIST(snets);
+    CLEAR_POINTER_LIST(splitNets);
+    names.clear();
+    name_cells.clear();
+    name_nets.clear();
+    name_splitNets.clear();
+    name_iopins.clear();
+    tracks.clear();
+    images.clear();
+    staInfos.clear();
+    databaseIssues.clear();
+    _nIndexedSplitNets = 0;
 
     DBU_Micron = -1.0;
     designName = "";
@@ -122,8 +137,7 @@ void Database::setupSplitNets() {
             if (net->nodes[i].comp() == static_cast<int>(numComps)) ++numComps;
         }
         for (unsigned i = 0; i != numComps; ++i) {
-            const string& name = net->name() + "_split_" + to_string(i);
-            SplitNet* splitNet = addSplitNet(name, net->ndr, net);
+            SplitNet* splitNet = addSplitNet(net, i);
             for (unsigned j = 0; j != net->nodes.size(); ++j) {
                 NetRouteNode& node = net->nodes[j];
                 if (node.comp() != static_cast<int>(i)) continue;
@@ -190,23 +204,34 @@ void Database::setupSplitNets() {
             splitNet->setCapacitance(sta::STALibraryIPin::default_capacitance,
                                      sta::STALibraryOPin::default_max_capacitance);
     }
-    for (SplitNet* splitNet : splitNets) {
-        splitNet->eraseBackslashInName();
+}
+
+void Database::setupRC() {
+    //  the extracted load stands in for the net detail report when there is none
+    const bool annotate = io::IOModule::NetDetail.empty();
+#pragma omp parallel for
+    for (unsigned i = 0; i < splitNets.size(); ++i) {
+        SplitNet* splitNet = splitNets[i];
+        splitNet->extractRC(cLayers, DBU_Micron, rlib.capacitanceUnit);
+        if (annotate) splitNet->totalCap(splitNet->loadCap() / rlib.capacitanceUnit);
     }
 }
 
-unsigned Database::setupImage(const unsigned imgIdx) {
+unsigned Database::setupImage(const vector<vector<unsigned>>& tileNets) {
     unsigned ret = 0;
     while (true) {
-        unsigned idx = 0;
+        unsigned tile = 0;
         {
             lock_guard<mutex> lock(snIdxMtx);
-            idx = snIdx;
+            tile = snIdx;
             ++snIdx;
         }
-        if (idx >= splitNets.size()) return ret;
-        images[imgIdx].setRouting(splitNets[idx], 0);
-        ++ret;
+        if (tile >= tileNets.size()) return ret;
+        images[0].touch(tile * ImageTileRows, (tile + 1) * ImageTileRows, 0, images[0].xNum());
+        for (const unsigned idx : tileNets[tile]) {
+            images[0].setRouting(splitNets[idx], 0, tile * ImageTileRows, (tile + 1) * ImageTileRows);
+        }
+        ret += tileNets[tile].size();
     }
 }
 
@@ -241,19 +266,33 @@ void Database::setupImages() {
             }
         }
     }
-    images.resize(DBModule::CPU, Image(xOrigin, yOrigin, xStep, yStep, xNum, yNum));
+    if (io::IOModule::ImageDir.size()) io::IOModule::writeDir(io::IOModule::ImageDir);
+    images.assign(1, Image::tiled(xOrigin, yOrigin, xStep, yStep, xNum, yNum, io::IOModule::ImageDir));
+
+    //  bin the split nets by the bands of rows they touch, each band is drawn by one worker at a time
+    vector<vector<unsigned>> tileNets((yNum + ImageTileRows - 1) / ImageTileRows);
+    for (unsigned i = 0; i != splitNets.size(); ++i) {
+        const SplitNet* splitNet = splitNets[i];
+        if (splitNet->nodes.empty()) continue;
+        const int lo = static_cast<int>(floor((splitNet->ly() - yOrigin) / yStep));
+        const int hi = static_cast<int>(floor((splitNet->hy() - yOrigin) / yStep));
+        const unsigned tileLo = max(0, lo) / ImageTileRows;
+        const unsigned tileHi = min<int>(yNum - 1, max(0, hi)) / ImageTileRows;
+        for (unsigned tile = tileLo; tile <= tileHi; ++tile) tileNets[tile].push_back(i);
+    }
     vector<future<unsigned>> futs;
     snIdx = 0;
-    for (unsigned i = 0; i != DBModule::CPU; ++i) futs.push_back(async(&Database::setupImage, this, i));
+    for (unsigned i = 0; i != DBModule::CPU; ++i) futs.push_back(async(&Database::setupImage, this, cref(tileNets)));
     for (future<unsigned>& fut : futs) fut.get();
-    for (unsigned i = 1; i < DBModule::CPU; ++i) images[0] += images[i];
-    images.resize(1);
+    //  the patches of the vias are at 1x, 2x and 4x pitch
+    pyramid.setup(images[0], 3, io::IOModule::ImageDir);
+    density.setup(images[0], cells, io::IOModule::ImageDir);
 }
 
-void Database::setupGraph() {
+bool Database::setupGraph() {
     if (splitNets.empty()) {
         printlog(LOG_ERROR, "no split net %s : %d", __FILE__, __LINE__);
-        return;
+        return false;
     }
 
     vector<SplitNet*> cleanSplitNets;
@@ -265,7 +304,7 @@ void Database::setupGraph() {
 
     if (cleanSplitNets.empty()) {
         printlog(LOG_ERROR, "no clean split net %s : %d", __FILE__, __LINE__);
-        return;
+        return false;
     }
 
     unsigned dir = 0;
@@ -284,7 +323,7 @@ void Database::setupGraph() {
                 default:
                     printlog(
                         LOG_ERROR, "unidentified layer direction %c in %s : %d", layer->direction, __FILE__, __LINE__);
-                    return;
+                    return false;
             }
         } else if (layer->rIdx == static_cast<int>(DBModule::Metal)) {
             switch (layer->direction) {
@@ -297,20 +336,23 @@ void Database::setupGraph() {
                 default:
                     printlog(
                         LOG_ERROR, "unidentified layer direction %c in %s : %d", layer->direction, __FILE__, __LINE__);
-                    return;
+                    return false;
             }
         }
     }
-    graph.run(cleanSplitNets, images[0], *this, pitch, dir, io::IOModule::DefPlacement);
+    return graph.run(cleanSplitNets, pyramid, density, *this, pitch, dir, io::IOModule::DefPlacement);
 }
 
-void Database::setup() {
+bool Database::setup() {
+    io::IOModule::forgetDirs();
     setupSplitNets();
+    setupRC();
     setupImages();
     if (io::IOModule::NetDetail.length()) database.readNetDetail(io::IOModule::NetDetail);
     if (io::IOModule::TimePath.length()) database.readTimePath(io::IOModule::TimePath, true);
     if (io::IOModule::TimeUnconstrain.length()) database.readTimePath(io::IOModule::TimeUnconstrain, false);
-    setupGraph();
+    if (io::IOModule::Liberty.length()) setupSTA();
+    return setupGraph();
 }
 
 long long Database::getHPWL() {
@@ -359,6 +401,5 @@ void DBModule::showOptions() {
 
 bool DBModule::setup() {
     showOptions();
-    database.setup();
-    return true;
+    return database.setup();
 }
@@ -70,6 +70,8 @@ class EdgeTypes;
 class GCell;
 class Geometry;
 class Image;
+class ImageDensity;
+class ImagePyramid;
 class Interval;
 class IOPin;
 class Layer;
@@ -98,12 +100,18 @@ using boostBox = bg::model::box<boostPoint>;
 
 }  // namespace db
 
+namespace sta {
+class STALibrary;
+}  // namespace sta
+
 #include "db_cell.h"
+#include "db_column.h"
 #include "db_drc.h"
 #include "db_geom.h"
 #include "db_image.h"
 #include "db_layer.h"
 #include "db_map.h"
+#include "db_name.h"
 #include "db_net.h"
 #include "db_pin.h"
 #include "db_place.h"
@@ -145,14 +153,20 @@ public:
     };
 
     unordered_map<string, CellType*> name_celltypes;
-    unordered_map<string, Cell*> name_cells;
-    unordered_map<string, Net*> name_nets;
-    unordered_map<string, SplitNet*> name_splitNets;
+    //  cells, nets and split nets are keyed on ids interned in `names`
+    NamePool names;
+    unordered_map<unsigned, Cell*> name_cells;
+    unordered_map<unsigned, Net*> name_nets;
+    unordered_map<unsigned, SplitNet*> name_splitNets;
     unordered_map<string, IOPin*> name_iopins;
     unordered_map<string, ViaType*> name_viatypes;
 
     vector<Layer*> layers;
     unsigned nLayers = 0;
+    //  dense lookup tables filled by addLayer
+    vector<Layer*> rLayers;
+    vector<Layer*> cLayers;
+    unordered_map<string_view, Layer*> name_layers;
 
     vector<ViaType*> viatypes;
     vector<CellType*> celltypes;
@@ -168,16 +182,23 @@ public:
     vector<Track> tracks;
 
     vector<Image> images;
+    ImagePyramid pyramid;
+    ImageDensity density;
     unsigned snIdx;
     mutex snIdxMtx;
     Graph<SplitNet> graph;
     //  Graph<Pin> graph;
+    //  timing of the pins, pointed to by Pin::staInfo
+    vector<PinSTA> staInfos;
 
 private:
     const size_t _bufferCapacity = 128 * 1024;
     size_t _bufferSize = 0;
     char* _buffer = nullptr;
 
+    //  split nets are indexed by name on demand, so `name_splitNets` is filled lazily by `indexSplitNets`
+    unsigned _nIndexedSplitNets = 0;
+
     vector<Placement> _placements;
     unsigned _activePlacement;
 
@@ -206,7 +227,10 @@ public:
     ~Database();
     void clear();
     void clearTechnology();
-    void clearLibrary() { CLEAR_POINTER_LIST(celltypes); }
+    void clearLibrary() {
+        CLEAR_POINTER_LIST(celltypes);
+        name_celltypes.clear();
+    }
     void clearDesign();
 
     Layer* addLayer(const string& name, const char type = 'x');
@@ -216,6 +240,7 @@ public:
     IOPin* addIOPin(const string& name = "", const string& netName = "", const char direction = 'x');
     Net* addNet(const string& name, const NDR* ndr, const unsigned nLayers);
     SplitNet* addSplitNet(const string& name, const NDR* ndr, const Net* net);
+    SplitNet* addSplitNet(const Net* net, const unsigned comp);
     SplitNet* addSplitNet(Pin* pin, const Layer* splitLayer);
     Row* addRow(const string& name,
                 const string& macro = "",
@@ -237,12 +262,15 @@ public:
 
     Layer* getRLayer(const int index);
     const Layer* getCLayer(const unsigned index) const;
-    Layer* getLayer(const string& name);
+    Layer* getLayer(const string_view name);
     CellType* getCellType(const string& name);
-    Cell* getCell(const string& name);
-    Net* getNet(const string& name);
-    Net* getNetHint(const string& name);
-    SplitNet* getSplitNet(const string& name);
+    Cell* getCell(const string_view name);
+    Net* getNet(const string_view name);
+    Net* getNetHint(const string_view name);
+    //  index the split nets added since the last call; getSplitNet does so itself, call this first to look them up
+    //  concurrently
+    void indexSplitNets();
+    SplitNet* getSplitNet(const string_view name);
     Region* getRegion(const string& name);
     Region* getRegion(const unsigned char id);
     NDR* getNDR(const string& name) const;
@@ -274,7 +302,7 @@ public:
     bool globalRouted();
     bool detailedRouted();
 
-    void setup();  // call after read
+    bool setup();  // call after read
 
     long long getHPWL();
 
@@ -282,6 +310,8 @@ public:
 public:
     bool readLEF(const std::string& file);
     bool readDEF(const string& file);
+    /* defined in io/file_def_nets.cpp */
+    bool readDefNets(const char* begin, const char* end);
 
     bool readBSAux(const std::string& auxFile, const std::string& plFile);
     bool readBSNodes(const std::string& file);
@@ -293,6 +323,8 @@ public:
     bool readBSPl(const std::string& file);
     bool writeBSPl(const std::string& file);
 
+    /* defined in io/file_liberty.y */
+    //  parse `file`, or read its cache, then bind it into `rlib` and the cell types
     bool readLiberty(const std::string& file);
 
     bool readNetDetail(const std::string& file);
@@ -300,9 +332,14 @@ public:
 
 private:
     void setupSplitNets();
-    unsigned setupImage(const unsigned imgIdx);
+    void setupRC();
+    //  rows of the die image in a tile of the parallel rasterization
+    static constexpr unsigned ImageTileRows = 64;
+    unsigned setupImage(const vector<vector<unsigned>>& tileNets);
     void setupImages();
-    void setupGraph();
+    bool setupGraph();
+    /* defined in sta/sta_timer.cpp */
+    void setupSTA();
 };
 
 }  // namespace db
@@ -23,6 +23,14 @@ Layer* Database::addLayer(const string& name, const char type) {
         }
     }
     layers.push_back(newlayer);
+    if (newlayer->rIdx >= 0) {
+        if (static_cast<int>(rLayers.size()) <= newlayer->rIdx) rLayers.resize(newlayer->rIdx + 1, nullptr);
+        rLayers[newlayer->rIdx] = newlayer;
+    } else if (newlayer->cIdx >= 0) {
+        if (static_cast<int>(cLayers.size()) <= newlayer->cIdx) cLayers.resize(newlayer->cIdx + 1, nullptr);
+        cLayers[newlayer->cIdx] = newlayer;
+    }
+    name_layers.emplace(newlayer->name(), newlayer);
     if (type == 'r') ++nLayers;
     return newlayer;
 }
@@ -70,11 +78,12 @@ Cell* Database::addCell(const string& name, CellType* type) {
         }
         return cell;
     }
-    cell = new Cell(name, type);
+    const unsigned id = names.intern(name);
+    cell = new Cell(names.name(id), type);
 #ifdef _GNUC_4_8_
-    name_cells.emplace(name, cell);
+    name_cells.emplace(id, cell);
 #else
-    name_cells[name] = cell;
+    name_cells[id] = cell;
 #endif
     cells.push_back(cell);
     return cell;
@@ -104,11 +113,12 @@ Net* Database::addNet(const string& name, const NDR* ndr, const unsigned nLayers
         printlog(LOG_WARN, "Net re-defined: %s", n.c_str());
         return net;
     }
-    net = new Net(n, ndr, Use::UseEnum::Signal, nLayers);
+    const unsigned id = names.intern(n);
+    net = new Net(names.name(id), ndr, Use::UseEnum::Signal, nLayers);
 #ifdef _GNUC_4_8_
-    name_nets.emplace(n, net);
+    name_nets.emplace(id, net);
 #else
-    name_nets[n] = net;
+    name_nets[id] = net;
 #endif
     nets.push_back(net);
     return net;
@@ -125,29 +135,24 @@ SplitNet* Database::addSplitNet(const string& name, const NDR* ndr, const Net* n
         printlog(LOG_ERROR, "Parent Net non-defined: %s", name.c_str());
         return nullptr;
     }
-    splitNet = new SplitNet(name, ndr, net);
-    name_splitNets[name] = splitNet;
+    splitNet = new SplitNet(names.name(names.intern(name)), ndr, net);
+    splitNets.push_back(splitNet);
+    return splitNet;
+}
+
+SplitNet* Database::addSplitNet(const Net* net, const unsigned comp) {
+    SplitNet* splitNet = new SplitNet(names.name(names.intern(SplitNet::nameOf(net, comp))), net->ndr, net);
     splitNets.push_back(splitNet);
     return splitNet;
 }
 
 SplitNet* Database::addSplitNet(Pin* pin, const Layer* splitLayer) {
-    string name;
-    if (pin->cell) {
-        name = pin->cell->name() + "_" + pin->type->name();
-    } else if (pin->iopin) {
-        name = pin->iopin->name;
-    } else {
+    if (!pin->cell && !pin->iopin) {
         printlog(LOG_ERROR, "invalid pin %s:%d", __FILE__, __LINE__);
+        return nullptr;
     }
 
-    SplitNet* splitNet = getSplitNet(name);
-    if (splitNet) {
-        printlog(LOG_WARN, "Split Net re-defined: %s", name.c_str());
-        return splitNet;
-    }
-
-    splitNet = new SplitNet(name, nullptr, pin->net());
+    SplitNet* splitNet = new SplitNet(names.name(names.intern(SplitNet::nameOf(pin))), nullptr, pin->net());
     pin->splitNet(splitNet);
     splitNet->addPin(pin);
     int x = INT_MIN;
@@ -158,7 +163,6 @@ SplitNet* Database::addSplitNet(Pin* pin, const Layer* splitLayer) {
     splitNet->addNode(nrn, false);
     splitNet->addUpVia(nrn);
 
-    name_splitNets[name] = splitNet;
     splitNets.push_back(splitNet);
 
     return splitNet;
@@ -201,7 +205,7 @@ NDR* Database::addNDR(const string& name, const bool hardSpacing) {
 }
 
 Net* Database::addSNet(const string& name, const Use::UseEnum use) {
-    Net* newsnet = new Net(name, nullptr, use, 0);
+    Net* newsnet = new Net(names.name(names.intern(name)), nullptr, use, 0);
     snets.push_back(newsnet);
     return newsnet;
 }
@@ -14,7 +14,7 @@ Cell::~Cell() {
     }
 }
 
-Pin* Cell::pin(const std::string& name) const {
+Pin* Cell::pin(const string_view name) const {
     for (Pin* pin : _pins) {
         if (pin->type->name() == name) {
             return pin;
@@ -28,7 +28,7 @@ void Cell::ctype(CellType* t) {
         return;
     }
     if (_type) {
-        printlog(LOG_ERROR, "type of cell %s already set", _name.c_str());
+        printlog(LOG_ERROR, "type of cell %s already set", _name.data());
         return;
     }
     _type = t;
@@ -54,19 +54,19 @@ bool Cell::placed() const { return database.placement().placed(const_cast<Cell*>
 
 void Cell::place(int x, int y) {
     if (_fixed) {
-        printlog(LOG_WARN, "moving fixed cell %s to (%d,%d)", _name.c_str(), x, y);
+        printlog(LOG_WARN, "moving fixed cell %s to (%d,%d)", _name.data(), x, y);
     }
     database.placement().place(this, x, y);
 }
 
 void Cell::place(int x, int y, bool r90, bool flipX, bool flipY) {
-    if (_fixed) printlog(LOG_WARN, "moving fixed cell %s to (%d,%d)", _name.c_str(), x, y);
+    if (_fixed) printlog(LOG_WARN, "moving fixed cell %s to (%d,%d)", _name.data(), x, y);
     database.placement().place(this, x, y, r90, flipX, flipY);
 }
 
 void Cell::unplace() {
     if (_fixed) {
-        printlog(LOG_WARN, "unplace fixed cell %s", _name.c_str());
+        printlog(LOG_WARN, "unplace fixed cell %s", _name.data());
     }
     database.placement().place(this);
 }
@@ -62,7 +62,8 @@ public:
 
 class Cell {
 private:
-    string _name = "";
+    //  view into `Database::names`
+    string_view _name = "";
     int _spaceL = 0;
     int _spaceR = 0;
     int _spaceB = 0;
@@ -75,12 +76,12 @@ public:
     bool highlighted = false;
     Region* region = nullptr;
 
-    Cell(const string& name = "", CellType* type = nullptr) : _name(name) { ctype(type); }
+    Cell(const string_view name = "", CellType* type = nullptr) : _name(name) { ctype(type); }
     ~Cell();
 
-    const string& name() const { return _name; }
+    string_view name() const { return _name; }
     const vector<Pin*>& pins() const { return _pins; }
-    Pin* pin(const std::string& name) const;
+    Pin* pin(const string_view name) const;
     Pin* pin(unsigned i) const { return _pins[i]; }
     CellType* ctype() const { return _type; }
     void ctype(CellType* t);
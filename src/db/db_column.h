@@ -0,0 +1,67 @@
+#ifndef _DB_COLUMN_H_
+#define _DB_COLUMN_H_
+
+#include <functional>
+#include <type_traits>
+
+#include "../io/file_table.h"
+
+namespace db {
+//  A column of an output table: its header, its type and the extractor of its value for a row
+template <typename Row>
+class Column {
+public:
+    using Extractor = function<io::ColumnValue(const Row&)>;
+
+    string name;
+    io::ColumnType type;
+    Extractor extract;
+
+    Column(const string& name, const io::ColumnType type, Extractor extract)
+        : name(name), type(type), extract(move(extract)) {}
+    //  typed after the values returned by `f`, integers, floating points or strings
+    template <typename F>
+    Column(const string& name, F f) : name(name) {
+        using Value = decay_t<invoke_result_t<F, const Row&>>;
+        if constexpr (is_floating_point_v<Value>) {
+            type = io::ColumnType::Double;
+            extract = [f](const Row& row) { return io::ColumnValue(static_cast<double>(f(row))); };
+        } else if constexpr (is_integral_v<Value> && !is_same_v<Value, char>) {
+            type = io::ColumnType::Int;
+            extract = [f](const Row& row) { return io::ColumnValue(static_cast<long long>(f(row))); };
+        } else if constexpr (is_same_v<Value, char>) {
+            type = io::ColumnType::String;
+            extract = [f](const Row& row) { return io::ColumnValue(string(1, f(row))); };
+        } else {
+            type = io::ColumnType::String;
+            extract = [f](const Row& row) { return io::ColumnValue(string(f(row))); };
+        }
+    }
+};
+
+//  The selected columns of a table, in the order of `all`; every column when none is selected
+template <typename Row>
+vector<Column<Row>> selectColumns(vector<Column<Row>>&& all, const vector<string>& selected) {
+    if (selected.empty()) return move(all);
+    vector<Column<Row>> columns;
+    for (Column<Row>& column : all) {
+        if (find(selected.begin(), selected.end(), column.name) != selected.end()) columns.push_back(move(column));
+    }
+    return columns;
+}
+
+template <typename Row>
+vector<io::ColumnSchema> schemaOf(const vector<Column<Row>>& columns) {
+    vector<io::ColumnSchema> schema;
+    for (const Column<Row>& column : columns) schema.push_back({column.name, column.type});
+    return schema;
+}
+
+template <typename Row>
+void addRow(io::RowGroup& rows, const vector<Column<Row>>& columns, const Row& row) {
+    for (unsigned i = 0; i != columns.size(); ++i) rows.push(i, columns[i].extract(row));
+    rows.endRow();
+}
+}  // namespace db
+
+#endif
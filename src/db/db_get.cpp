@@ -4,36 +4,31 @@ using namespace db;
 #include "../ut/utils.h"
 
 /* get layer by name */
-Layer* Database::getLayer(const string& name)
+Layer* Database::getLayer(const string_view name)
 {
-    for (Layer* layer : layers) {
-        if (layer->name() == name) {
-            return layer;
-        }
+    unordered_map<string_view, Layer*>::iterator mi = name_layers.find(name);
+    if (mi == name_layers.end()) {
+        return nullptr;
     }
-    return nullptr;
+    return mi->second;
 }
 
 /* get routing layer by index : 0=M1 */
 Layer* Database::getRLayer(const int index)
 {
-    for (Layer* layer : layers) {
-        if (layer->rIdx == index) {
-            return layer;
-        }
+    if (index < 0 || index >= static_cast<int>(rLayers.size())) {
+        return nullptr;
     }
-    return nullptr;
+    return rLayers[index];
 }
 
 /* get cut layer by index : 0=M1/2 */
 const Layer* Database::getCLayer(const unsigned index) const
 {
-    for (const Layer* layer : layers) {
-        if (layer->cIdx == (int)index) {
-            return layer;
-        }
+    if (index >= cLayers.size()) {
+        return nullptr;
     }
-    return nullptr;
+    return cLayers[index];
 }
 
 /* get cell type by name */
@@ -46,38 +41,57 @@ CellType* Database::getCellType(const string& name)
     return mi->second;
 }
 
-Cell* Database::getCell(const string& name) {
-    unordered_map<string, Cell*>::iterator mi = name_cells.find(name);
+Cell* Database::getCell(const string_view name) {
+    const unsigned id = names.find(name);
+    if (id == NamePool::None) {
+        return nullptr;
+    }
+    unordered_map<unsigned, Cell*>::iterator mi = name_cells.find(id);
     if (mi == name_cells.end()) {
         return nullptr;
     }
     return mi->second;
 }
 
-Net* Database::getNet(const string& name) {
-    unordered_map<string, Net*>::iterator mi = name_nets.find(name);
+Net* Database::getNet(const string_view name) {
+    const unsigned id = names.find(name);
+    if (id == NamePool::None) {
+        return nullptr;
+    }
+    unordered_map<unsigned, Net*>::iterator mi = name_nets.find(id);
     if (mi == name_nets.end()) {
         return nullptr;
     }
     return mi->second;
 }
 
-Net* Database::getNetHint(const string& name) {
-    for (const auto & [ netname, net ] : name_nets) {
-        if (name.find(netname)) {
-            continue;
-        } else if (name.size() == netname.size()) {
-            return net;
-        } else if (name[netname.size()] == '_') {
-            return net;
-        }
+/* get the net whose name is `name` or a prefix of `name` followed by '_' */
+Net* Database::getNetHint(const string_view name) {
+    //  try the candidate prefixes from the longest one, each is a single interned lookup
+    for (size_t len = name.size(); len != string_view::npos; len = name.rfind('_', len - 1)) {
+        Net* net = getNet(name.substr(0, len));
+        if (net) return net;
+        if (!len) break;
     }
     return nullptr;
 }
 
-SplitNet* Database::getSplitNet(const string& name)
+void Database::indexSplitNets()
+{
+    for (; _nIndexedSplitNets < splitNets.size(); ++_nIndexedSplitNets) {
+        SplitNet* splitNet = splitNets[_nIndexedSplitNets];
+        name_splitNets.emplace(names.intern(splitNet->name()), splitNet);
+    }
+}
+
+SplitNet* Database::getSplitNet(const string_view name)
 {
-    unordered_map<string, SplitNet*>::iterator mi = name_splitNets.find(name);
+    indexSplitNets();
+    const unsigned id = names.find(name);
+    if (id == NamePool::None) {
+        return nullptr;
+    }
+    unordered_map<unsigned, SplitNet*>::iterator mi = name_splitNets.find(id);
     if (mi == name_splitNets.end()) {
         return nullptr;
     }
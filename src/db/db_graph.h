@@ -21,66 +21,98 @@ public:
     const T* inet() const { return _inet; }
     double cost() const { return _cost; }
 
-    unsigned write(
-        ostream& os, const string& design, const Rectangle& die, const Point& pitch, const unsigned dir) const;
+    //  the columns of the arc itself, also in the arc table
+    static vector<Column<GraphArc<T>>> edgeColumns(const Rectangle& die, const Point& pitch, const unsigned dir);
+    //  every column of the arc table
+    static vector<Column<GraphArc<T>>> columns(const Rectangle& die, const Point& pitch, const unsigned dir);
+    unsigned write(io::RowGroup& rows, const vector<Column<GraphArc<T>>>& columns) const;
 
     bool operator<(const GraphArc<T>& rhs) { return _cost < rhs._cost; }
 };
 
 template <typename T>
-unsigned GraphArc<T>::write(
-    ostream& os, const string& design, const Rectangle& die, const Point& pitch, const unsigned dir) const {
-    const NetRouteUpNode& onode = _onet->upVias[_onodeIdx];
-    const NetRouteUpNode& inode = _inet->upVias[_inodeIdx];
-    const int dx = onode[dir] - inode[dir];
-    const int dy = onode[1 - dir] - inode[1 - dir];
-    const double px = dx / static_cast<double>(pitch[dir]);
-    const double py = dy / static_cast<double>(pitch[1 - dir]);
-    const double rx = dx / static_cast<double>(die[dir].range());
-    const double ry = dy / static_cast<double>(die[1 - dir].range());
-    const unsigned numOPins = _onet->numOPins();
-    os << _onet->name() << ',' << _inet->name() << ',' << _onodeIdx << ',' << _inodeIdx << ',' << px << ',' << py << ','
-       << abs(px) << ',' << abs(py) << ',' << rx << ',' << ry << ',' << abs(rx) << ',' << abs(ry) << ',' << numOPins
-       << ',' << _inet->numOPins() << ',';
-
-    if (_onet->upPin()) {
-        os << "1,";
-    } else {
-        os << "0,";
-    }
-
-    if (_inet->upPin()) {
-        os << "1,";
-    } else {
-        os << "0,";
-    }
+vector<Column<GraphArc<T>>> GraphArc<T>::edgeColumns(const Rectangle& die, const Point& pitch, const unsigned dir) {
+    using Arc = const GraphArc<T>&;
+    //  from the driver via to the sink via along `d`
+    const auto delta = [](Arc a, const unsigned d) {
+        return a._onet->upVias[a._onodeIdx][d] - a._inet->upVias[a._inodeIdx][d];
+    };
+    const double px = pitch[dir];
+    const double py = pitch[1 - dir];
+    const double rx = die[dir].range();
+    const double ry = die[1 - dir].range();
+    return {
+        {"SNK_VIA_IDX", [](Arc a) { return a._onodeIdx; }},
+        {"DRV_VIA_IDX", [](Arc a) { return a._inodeIdx; }},
+        {"SIGNED_ABSOLUTE_DIST_X", [=](Arc a) { return delta(a, dir) / px; }},
+        {"SIGNED_ABSOLUTE_DIST_Y", [=](Arc a) { return delta(a, 1 - dir) / py; }},
+        {"UNSIGNED_ABSOLUTE_DIST_X", [=](Arc a) { return abs(delta(a, dir) / px); }},
+        {"UNSIGNED_ABSOLUTE_DIST_Y", [=](Arc a) { return abs(delta(a, 1 - dir) / py); }},
+        {"SIGNED_RELATIVE_DIST_X", [=](Arc a) { return delta(a, dir) / rx; }},
+        {"SIGNED_RELATIVE_DIST_Y", [=](Arc a) { return delta(a, 1 - dir) / ry; }},
+        {"UNSIGNED_RELATIVE_DIST_X", [=](Arc a) { return abs(delta(a, dir) / rx); }},
+        {"UNSIGNED_RELATIVE_DIST_Y", [=](Arc a) { return abs(delta(a, 1 - dir) / ry); }},
+        {"LABEL", [](Arc a) { return a._onet->parent() == a._inet->parent() ? 1 : 0; }},
+    };
+}
 
-    os << _onet->pitchLen() << ',' << _onet->numVias() << ',' << _onet->pitchLen(DBModule::Metal - 1) << ',';
-    for (int i = static_cast<int>(DBModule::Metal) - 2; i != static_cast<int>(DBModule::Metal) - 5; --i) {
-        if (i >= 0) {
-            os << _onet->numVias(i) << ',' << _onet->pitchLen(i) << ',';
-        } else {
-            os << 0 << ',' << 0 << ',';
-        }
-    }
-    os << _inet->pitchLen() << ',' << _inet->numVias() << ',' << _inet->pitchLen(DBModule::Metal - 1) << ',';
-    for (int i = static_cast<int>(DBModule::Metal) - 2; i != static_cast<int>(DBModule::Metal) - 5; --i) {
-        if (i >= 0) {
-            os << _inet->numVias(i) << ',' << _inet->pitchLen(i) << ',';
-        } else {
-            os << 0 << ',' << 0 << ',';
-        }
+template <typename T>
+vector<Column<GraphArc<T>>> GraphArc<T>::columns(const Rectangle& die, const Point& pitch, const unsigned dir) {
+    using Arc = const GraphArc<T>&;
+    vector<Column<GraphArc<T>>> edge = edgeColumns(die, pitch, dir);
+    //  those of the split nets at both ends but their parents and RC, by SplitNet::netColumns
+    vector<Column<GraphArc<T>>> snk;
+    vector<Column<GraphArc<T>>> drv;
+    for (const Column<const SplitNet*>& column : SplitNet::netColumns()) {
+        if (column.name == "PARENT" || !column.name.compare(0, 3, "RC_")) continue;
+        snk.emplace_back(
+            "SNK_" + column.name, column.type, [extract = column.extract](Arc a) { return extract(a._onet); });
+        drv.emplace_back(
+            "DRV_" + column.name, column.type, [extract = column.extract](Arc a) { return extract(a._inet); });
     }
+    vector<Column<GraphArc<T>>> columns = {snk[0], drv[0]};
+    //  the label ends the table
+    columns.insert(columns.end(), edge.begin(), edge.end() - 1);
+    //  the sink counts and up pins side by side, then the routing of each end
+    columns.insert(columns.end(), {snk[1], drv[1], snk[2], drv[2]});
+    columns.insert(columns.end(), snk.begin() + 3, snk.end());
+    columns.insert(columns.end(), drv.begin() + 3, drv.end());
+    columns.push_back(edge.back());
+    return columns;
+}
 
-    if (_onet->parent() == _inet->parent()) {
-        os << "1\n";
-        return numOPins;
-    } else {
-        os << "0\n";
-        return 0;
-    }
+template <typename T>
+unsigned GraphArc<T>::write(io::RowGroup& rows, const vector<Column<GraphArc<T>>>& columns) const {
+    addRow(rows, columns, *this);
+    return _onet->parent() == _inet->parent() ? _onet->numOPins() : 0;
 }
 
+//  a split net as a virtual pin of the wsc table, with the id of the virtual pin it is matched to
+template <typename T>
+struct GraphPin {
+    const T* net;
+    unsigned id;
+    unsigned match;
+    bool isDriver;
+};
+
+//  a split net as a node of the candidate graph, whose arcs are the edges from EDGE_BEGIN to the EDGE_BEGIN of the
+//  next node
+template <typename T>
+struct GraphNode {
+    const T* net;
+    unsigned id;
+    bool isDriver;
+    unsigned edgeBegin;
+};
+
+template <typename T>
+struct GraphEdge {
+    const GraphArc<T>* arc;
+    unsigned snk;
+    unsigned drv;
+};
+
 template <typename T>
 class Graph {
 private:
@@ -103,18 +135,37 @@ public:
     static unsigned nFlows;
     static unsigned nCoveredNets;
     static unsigned nCoveredPins;
-    static ofstream selOfs;
+    static io::TableFile* selTable;
+    static vector<Column<GraphArc<T>>> arcColumns;
+    //  the arcs of each sink, kept for the graph tables
+    static vector<vector<GraphArc<T>>> sinkArcs;
+    static mutex patchMtx;
+    //  the first file of each distinct patch content
+    static unordered_map<ImageDigest, string, ImageDigestHash> patchFiles;
+    //  files with the same content as an earlier one, linked to it once all the patches are written
+    static vector<pair<string, string>> patchLinks;
 
 private:
     void addNode(T* splitNet);
-    static void writeSel(
-        const T* onet, const string& design, const Rectangle& die, const Point& pitch, const unsigned dir);
-    static void writeImg(
-        const T* splitNet, const vector<T*>& splitNets, const Image& image, const string& path, const unsigned dir);
+    static vector<Column<GraphPin<T>>> pinColumns(const unsigned dir, const ImageDensity& density);
+    static void writeSel(const T* onet, const Rectangle& die, const unsigned dir, vector<GraphArc<T>>* kept);
+    void writeGraph(io::AsyncWriter& writer,
+                    const string& prefix,
+                    const string& ext,
+                    const Rectangle& die,
+                    const Point& pitch,
+                    const unsigned dir);
+    static void writeImg(const T* splitNet,
+                         const unsigned viaIdx,
+                         const ImagePyramid& pyramid,
+                         const string& path,
+                         const unsigned dir,
+                         io::AsyncWriter& writer);
 
 public:
     bool run(const vector<T*>& splitNets,
-             const Image& image,
+             const ImagePyramid& pyramid,
+             const ImageDensity& density,
              const Rectangle& die,
              const Point& pitch,
              const unsigned dir,
@@ -134,7 +185,17 @@ unsigned Graph<T>::nCoveredNets;
 template <typename T>
 unsigned Graph<T>::nCoveredPins;
 template <typename T>
-ofstream Graph<T>::selOfs;
+io::TableFile* Graph<T>::selTable;
+template <typename T>
+vector<Column<GraphArc<T>>> Graph<T>::arcColumns;
+template <typename T>
+vector<vector<GraphArc<T>>> Graph<T>::sinkArcs;
+template <typename T>
+mutex Graph<T>::patchMtx;
+template <typename T>
+unordered_map<ImageDigest, string, ImageDigestHash> Graph<T>::patchFiles;
+template <typename T>
+vector<pair<string, string>> Graph<T>::patchLinks;
 
 template <typename T>
 void Graph<T>::addNode(T* splitNet) {
@@ -149,8 +210,29 @@ void Graph<T>::addNode(T* splitNet) {
 }
 
 template <typename T>
-void Graph<T>::writeSel(
-    const T* onet, const string& design, const Rectangle& die, const Point& pitch, const unsigned dir) {
+vector<Column<GraphPin<T>>> Graph<T>::pinColumns(const unsigned dir, const ImageDensity& density) {
+    using Pin = const GraphPin<T>&;
+    const ImageDensity* d = &density;
+    return {
+        {"Vpin ID", [](Pin p) { return "S" + to_string(p.id); }},
+        {"X coordinate", [dir](Pin p) { return p.net->upVias[0][dir]; }},
+        {"Y coordinate", [dir](Pin p) { return p.net->upVias[0][1 - dir]; }},
+        {"WL down to L1", [](Pin p) { return p.net->len(); }},
+        {"Pin Type", [](Pin p) { return p.isDriver ? 'O' : 'I'; }},
+        {"NumberLayer One Pins", [](Pin p) { return p.net->numPins(); }},
+        {"Ave Cell Area Input", [](Pin p) { return p.net->oArea(); }},
+        {"Ave Cell Area Output", [](Pin p) { return p.isDriver ? p.net->iArea() : 0; }},
+        {"Ave Pin X coordinate", [dir](Pin p) { return p.net->meanPin()[dir]; }},
+        {"Ave Pin Y coordinate", [dir](Pin p) { return p.net->meanPin()[1 - dir]; }},
+        {"CongestionCrouting", [d](Pin p) { return d->routing(p.net->upVias[0].x(), p.net->upVias[0].y(), 49); }},
+        {"CongestionPlacement",
+         [d](Pin p) { return d->placement(p.net->upVias[0].x(), p.net->upVias[0].y(), 49); }},
+        {"Matching Vpin ID", [](Pin p) { return "S" + to_string(p.match); }},
+    };
+}
+
+template <typename T>
+void Graph<T>::writeSel(const T* onet, const Rectangle& die, const unsigned dir, vector<GraphArc<T>>* kept) {
     bool isMissed = true;
     bool isCovered = true;
     vector<GraphArc<T>> arcs;
@@ -205,7 +287,7 @@ void Graph<T>::writeSel(
             if (icap) {
                 isMissed = false;
             } else {
-                if (isLoop) printlog(LOG_WARN, "onet %s inet %s is loop", onet->name().c_str(), inet->name().c_str());
+                if (isLoop) printlog(LOG_WARN, "onet %s inet %s is loop", onet->name().data(), inet->name().data());
                 isCovered = false;
                 //  lock_guard<mutex> lock(selMtx);
                 //  ++totalNumONetsMissed;
@@ -214,6 +296,9 @@ void Graph<T>::writeSel(
         }
     }
 
+    io::RowGroup rows(schemaOf(arcColumns));
+    for (const GraphArc<T>& arc : arcs) arc.write(rows, arcColumns);
+
     lock_guard<mutex> lock(selMtx);
     if (isMissed) {
         ++totalNumONetsMissed;
@@ -224,120 +309,187 @@ void Graph<T>::writeSel(
         nCoveredPins += onet->numOPins();
     }
     nFlows += arcs.size();
-    for (const GraphArc<T>& arc : arcs) arc.write(selOfs, design, die, pitch, dir);
+    selTable->append(rows);
+    if (kept) *kept = move(arcs);
 }
 
+//  The candidate graph as a table of split nets, sinks first, and a table of arcs sorted by sink and cost, so that
+//  the features of a split net are written once instead of on each of its arcs
 template <typename T>
-void Graph<T>::writeImg(
-    const T* splitNet, const vector<T*>& splitNets, const Image& image, const string& path, const unsigned dir) {
-    for (unsigned i = 0; i != splitNet->upVias.size(); ++i) {
-        const NetRouteUpNode& node = splitNet->upVias[i];
-        int x = node.x();
-        int y = node.y();
-        for (unsigned j = 1; j <= 4; j *= 2) {
-            const double xOrigin = x - image.xStep() * j * 49.5;
-            const double yOrigin = y - image.yStep() * j * 49.5;
-            const double xStep = image.xStep() * j;
-            const double yStep = image.yStep() * j;
-            const int xCeil =
-                min<int>(image.xNum(), ceil((xOrigin + xStep * 99 - image.xOrigin()) / image.xStep()) + 0.5);
-            const int yCeil =
-                min<int>(image.yNum(), ceil((yOrigin + yStep * 99 - image.yOrigin()) / image.yStep()) + 0.5);
-            Image img(xOrigin, yOrigin, xStep, yStep, 99, 99);
-            img.setRouting(splitNet, 4);
-            for (unsigned yIdx = max<int>(0, (yOrigin - image.yOrigin()) / image.yStep());
-                 static_cast<int>(yIdx) < yCeil;
-                 ++yIdx) {
-                for (unsigned xIdx = max<int>(0, (xOrigin - image.xOrigin()) / image.xStep());
-                     static_cast<int>(xIdx) < xCeil;
-                     ++xIdx) {
-                    img.setData(image.yOrigin() + image.yStep() * (yIdx + 0.5),
-                                image.xOrigin() + image.xStep() * (xIdx + 0.5),
-                                image.data(yIdx, xIdx));
-                }
+void Graph<T>::writeGraph(io::AsyncWriter& writer,
+                          const string& prefix,
+                          const string& ext,
+                          const Rectangle& die,
+                          const Point& pitch,
+                          const unsigned dir) {
+    const vector<string>& selected = io::IOModule::Columns;
+    unordered_map<const T*, unsigned> nodeIds;
+    for (const T* onet : _onodes) nodeIds.emplace(onet, nodeIds.size());
+    for (const T* inet : inodes) nodeIds.emplace(inet, nodeIds.size());
+
+    using Node = const GraphNode<T>&;
+    vector<Column<GraphNode<T>>> nodeColumns = {
+        {"NODE", [](Node n) { return n.id; }},
+        {"DRIVER", [](Node n) { return n.isDriver ? 1 : 0; }},
+        {"EDGE_BEGIN", [](Node n) { return n.edgeBegin; }},
+    };
+    for (const Column<const T*>& column : selectColumns(T::netColumns(), selected)) {
+        nodeColumns.emplace_back(
+            column.name, column.type, [extract = column.extract](Node n) { return extract(n.net); });
+    }
+    using Edge = const GraphEdge<T>&;
+    vector<Column<GraphEdge<T>>> edgeColumns = {
+        {"SNK", [](Edge e) { return e.snk; }},
+        {"DRV", [](Edge e) { return e.drv; }},
+    };
+    for (const Column<GraphArc<T>>& column : selectColumns(GraphArc<T>::edgeColumns(die, pitch, dir), selected)) {
+        edgeColumns.emplace_back(
+            column.name, column.type, [extract = column.extract](Edge e) { return extract(*e.arc); });
+    }
+
+    io::TableFile nodeTable(writer, prefix + ".nodes" + ext, schemaOf(nodeColumns), io::IOModule::Columnar);
+    io::TableFile edgeTable(writer, prefix + ".edges" + ext, schemaOf(edgeColumns), io::IOModule::Columnar);
+    unsigned nEdges = 0;
+    for (unsigned i = 0; i != _onodes.size(); ++i) {
+        addRow(nodeTable.rows(), nodeColumns, {_onodes[i], i, false, nEdges});
+        vector<GraphArc<T>>& arcs = sinkArcs[i];
+        stable_sort(arcs.begin(), arcs.end(), [](const auto& lhs, const auto& rhs) { return lhs.cost() < rhs.cost(); });
+        for (const GraphArc<T>& arc : arcs) addRow(edgeTable.rows(), edgeColumns, {&arc, i, nodeIds[arc.inet()]});
+        nEdges += arcs.size();
+        nodeTable.flush();
+        edgeTable.flush();
+    }
+    for (const T* inet : inodes) {
+        addRow(nodeTable.rows(), nodeColumns, {inet, nodeIds[inet], true, nEdges});
+        nodeTable.flush();
+    }
+    printlog(LOG_INFO,
+             "writing %s.{nodes,edges}%s: %lu nodes %u edges",
+             prefix.c_str(),
+             ext.c_str(),
+             nodeIds.size(),
+             nEdges);
+}
+
+template <typename T>
+void Graph<T>::writeImg(const T* splitNet,
+                        const unsigned viaIdx,
+                        const ImagePyramid& pyramid,
+                        const string& path,
+                        const unsigned dir,
+                        io::AsyncWriter& writer) {
+    const NetRouteUpNode& node = splitNet->upVias[viaIdx];
+    //  all levels of a via are in the same shard
+    const string stem = string(splitNet->name()) + "_" + to_string(viaIdx);
+    string folder = path;
+    if (io::IOModule::ImageShards) folder += "/" + io::IOModule::imageShard(stem);
+    for (unsigned l = 0; l != pyramid.numLevels(); ++l) {
+        Image img = pyramid.crop(node.x(), node.y(), l, 99, 99);
+        img.setRouting(splitNet, 4);
+        const string file = folder + "/" + stem + "_" + to_string(1 << l) + ".png";
+        const vector<unsigned char> raw = img.raw(dir);
+        const ImageDigest digest = Image::digest(raw);
+        {
+            lock_guard<mutex> lock(patchMtx);
+            const auto pi = patchFiles.find(digest);
+            if (pi != patchFiles.end()) {
+                patchLinks.emplace_back(pi->second, file);
+                continue;
+            }
+        }
+        //  only a written patch is linked to, a duplicate of one that fails to encode tries on its own
+        string png = img.png(raw, dir);
+        if (png.empty()) continue;
+        {
+            lock_guard<mutex> lock(patchMtx);
+            const auto [pi, isNew] = patchFiles.emplace(digest, file);
+            //  encoded meanwhile by another thread
+            if (!isNew) {
+                patchLinks.emplace_back(pi->second, file);
+                continue;
             }
-            img.encode(path + "/" + splitNet->name() + "_" + to_string(i) + "_" + to_string(j) + ".png", dir);
         }
+        writer.write(file, move(png));
     }
 }
 
 template <typename T>
 bool Graph<T>::run(const vector<T*>& splitNets,
-                   const Image& image,
+                   const ImagePyramid& pyramid,
+                   const ImageDensity& density,
                    const Rectangle& die,
                    const Point& pitch,
                    const unsigned dir,
                    const string& file) {
+    //  the graph is built anew by each run
+    _nONodes = 0;
+    _nINodes = 0;
+    _nOPins = 0;
+    _onodes.clear();
+    inodes.clear();
     for (T* splitNet : splitNets) {
         if (splitNet->upVias.empty()) continue;
 
         addNode(splitNet);
     }
 
-    size_t pos0 = file.find_last_of('/');
-    string path = ".";
-    string csv = file;
-    if (pos0 != string::npos) {
-        path = file.substr(0, pos0);
-        csv = file.substr(pos0 + 1);
-    }
-    size_t pos1 = csv.find('.');
-    const string& base = csv.substr(0, pos1);
-    path = path + "/" + base;
+    const string path = io::IOModule::outputDir(file);
+    const string base = path.substr(path.find_last_of('/') + 1);
 
     size_t pos2 = base.find_last_of('_');
     const string& design = base.substr(0, pos2);
 
-    ofstream wscOfs = io::IOModule::write(path + "/" + base + ".wsc.csv", true);
-    ofstream drvOfs = io::IOModule::write(path + "/" + base + ".drv.csv", true);
-    ofstream snkOfs = io::IOModule::write(path + "/" + base + ".snk.csv", true);
-    wscOfs << "Vpin ID,X coordinate,Y coordinate,WL down to L1,Pin Type,NumberLayer One Pins,Ave Cell Area Input,Ave "
-              "Cell Area Output,Ave Pin X coordinate,Ave Pin Y "
-              "coordinate,CongestionCrouting,CongestionPlacement,Matching Vpin ID\n";
-    drvOfs << "DESIGN,PARENT,NAME,VIA_IDX,VIA_ABSOLUTE_X,VIA_ABSOLUTE_Y,VIA_RELATIVE_X,VIA_RELATIVE_Y,DIR_NN,DIR_NP,"
-              "DIR_PN,DIR_PP,SINK_COUNT,UP_PIN,WL,VIAS,WL_M4";
-    snkOfs << "DESIGN,PARENT,NAME,VIA_IDX,VIA_ABSOLUTE_X,VIA_ABSOLUTE_Y,VIA_RELATIVE_X,VIA_RELATIVE_Y,DIR_NN,DIR_NP,"
-              "DIR_PN,DIR_PP,SINK_COUNT,UP_PIN,WL,VIAS,WL_M4";
-    for (unsigned i = 3; i; --i) {
-        drvOfs << ",VIAS_V" << i << i + 1 << ",WL_M" << i;
-        snkOfs << ",VIAS_V" << i << i + 1 << ",WL_M" << i;
+    //  the compute threads only format the output, the I/O threads of `writer` write it meanwhile
+    io::AsyncWriter writer;
+    writer.captureTo(io::IOModule::Capture);
+    if (!writer.isCapturing()) io::IOModule::writeDir(path);
+    const bool columnar = io::IOModule::Columnar;
+    const string ext = columnar ? ".col" : ".csv";
+    //  only the selected columns are extracted
+    const vector<string>& selected = io::IOModule::Columns;
+    vector<Column<SplitNet::ViaRow>> viaColumns = SplitNet::columns(design, die, pitch, dir, density);
+    arcColumns = GraphArc<T>::columns(die, pitch, dir);
+    for (const string& name : selected) {
+        const auto isNamed = [&](const auto& column) { return column.name == name; };
+        if (none_of(viaColumns.begin(), viaColumns.end(), isNamed) &&
+            none_of(arcColumns.begin(), arcColumns.end(), isNamed)) {
+            printlog(LOG_WARN, "unknown column %s", name.c_str());
+        }
+    }
+    viaColumns = selectColumns(move(viaColumns), selected);
+    arcColumns = selectColumns(move(arcColumns), selected);
+    const vector<Column<GraphPin<T>>> wscColumns = pinColumns(dir, density);
+    io::TableFile wscTable(writer, path + "/" + base + ".wsc" + ext, schemaOf(wscColumns), columnar);
+    io::TableFile drvTable(writer, path + "/" + base + ".drv" + ext, schemaOf(viaColumns), columnar);
+    io::TableFile snkTable(writer, path + "/" + base + ".snk" + ext, schemaOf(viaColumns), columnar);
+    for (const char* table : {"wsc", "drv", "snk"}) {
+        printlog(LOG_INFO, "writing %s/%s.%s%s", path.c_str(), base.c_str(), table, ext.c_str());
     }
-    drvOfs << endl;
-    snkOfs << endl;
     for (unsigned inetIdx = 0; inetIdx != inodes.size(); ++inetIdx) {
         const T* inet = inodes[inetIdx];
         for (const T* onet : _onodes) {
             if (onet->parent() != inet->parent()) continue;
 
-            inet->write(drvOfs, design, die, pitch, dir);
-            onet->write(snkOfs, design, die, pitch, dir);
-            const NetRouteUpNode& ivia = inet->upVias[0];
-            const NetRouteUpNode& ovia = onet->upVias[0];
-            wscOfs << 'S' << inetIdx * 2 << ',' << ivia[dir] << ',' << ivia[1 - dir] << ',' << inet->len() << ",O,"
-                   << inet->numPins() << ',' << inet->oArea() << ',' << inet->iArea() << ',';
-            const Point iMeanPin = inet->meanPin();
-            wscOfs << iMeanPin[dir] << ',' << iMeanPin[1 - dir] << ",0,0,S" << inetIdx * 2 + 1 << endl;
-            wscOfs << 'S' << inetIdx * 2 + 1 << ',' << ovia[dir] << ',' << ovia[1 - dir] << ',' << onet->len() << ",I,"
-                   << onet->numPins() << ',' << onet->oArea() << ",0,";
-            const Point oMeanPin = onet->meanPin();
-            wscOfs << oMeanPin[dir] << ',' << oMeanPin[1 - dir] << ",0,0,S" << inetIdx * 2 << endl;
+            inet->write(drvTable.rows(), viaColumns);
+            onet->write(snkTable.rows(), viaColumns);
+            addRow(wscTable.rows(), wscColumns, {inet, inetIdx * 2, inetIdx * 2 + 1, true});
+            addRow(wscTable.rows(), wscColumns, {onet, inetIdx * 2 + 1, inetIdx * 2, false});
+            wscTable.flush();
+            drvTable.flush();
+            snkTable.flush();
             break;
         }
     }
-    wscOfs.close();
-    drvOfs.close();
-    snkOfs.close();
-
-    selOfs = io::IOModule::write(path + "/" + base + ".sel.csv", true);
-    selOfs << "SNK_NAME,DRV_NAME,SNK_VIA_IDX,DRV_VIA_IDX,SIGNED_ABSOLUTE_DIST_X,SIGNED_ABSOLUTE_DIST_Y,UNSIGNED_"
-              "ABSOLUTE_DIST_X,UNSIGNED_ABSOLUTE_DIST_Y,SIGNED_RELATIVE_DIST_X,SIGNED_RELATIVE_DIST_Y,UNSIGNED_"
-              "RELATIVE_DIST_X,UNSIGNED_RELATIVE_DIST_Y,SNK_SINK_COUNT,DRV_SINK_COUNT,SNK_UP_PIN,DRV_UP_PIN,SNK_WL,SNK_"
-              "VIAS,SNK_WL_M4,";
-    for (unsigned i = 3; i; --i) selOfs << "SNK_VIAS_V" << i << i + 1 << ",SNK_WL_M" << i << ',';
-    selOfs << "DRV_WL,DRV_VIAS,DRV_WL_M4,";
-    for (unsigned i = 3; i; --i) selOfs << "DRV_VIAS_V" << i << i + 1 << ",DRV_WL_M" << i << ',';
-    selOfs << "LABEL\n";
+    wscTable.close();
+    drvTable.close();
+    snkTable.close();
+
+    io::TableFile selOut(writer, path + "/" + base + ".sel" + ext, schemaOf(arcColumns), columnar);
+    printlog(LOG_INFO, "writing %s/%s.sel%s", path.c_str(), base.c_str(), ext.c_str());
+    selTable = &selOut;
 
+    const bool graphTables = io::IOModule::GraphTables;
+    sinkArcs.assign(graphTables ? _nONodes : 0, {});
     totalNumONetsMissed = 0;
     nFlows = 0;
     nCoveredNets = 0;
@@ -345,10 +497,15 @@ bool Graph<T>::run(const vector<T*>& splitNets,
 
 #pragma omp parallel for
     for (unsigned i = 0; i < _nONodes; ++i) {
-        Graph<T>::writeSel(_onodes[i], design, die, pitch, dir);
+        Graph<T>::writeSel(_onodes[i], die, dir, graphTables ? &sinkArcs[i] : nullptr);
     }
 
-    selOfs.close();
+    selOut.close();
+    selTable = nullptr;
+    if (graphTables) {
+        writeGraph(writer, path + "/" + base, ext, die, pitch, dir);
+        sinkArcs.clear();
+    }
     if (totalNumONetsMissed) {
         printlog(LOG_WARN,
                  "%u / %u = %f sink nets missed while adding arcs",
@@ -368,17 +525,48 @@ bool Graph<T>::run(const vector<T*>& splitNets,
              _nOPins,
              nCoveredPins / static_cast<double>(_nOPins));
 
-#pragma omp parallel for
-    for (unsigned i = 0; i < _nONodes; ++i) {
-        Graph<T>::writeImg(_onodes[i], splitNets, image, path, dir);
+    //  patches along a Hilbert curve over the vias, so that consecutive patches overlap in the image and few tiles
+    //  are in use at a time; chunks keep neighbours on the same thread
+    vector<pair<size_t, pair<const T*, unsigned>>> patches;
+    for (const vector<T*>* nodes : {&_onodes, &inodes}) {
+        for (const T* splitNet : *nodes) {
+            for (unsigned i = 0; i != splitNet->upVias.size(); ++i) {
+                const NetRouteUpNode& node = splitNet->upVias[i];
+                patches.push_back({pyramid.image().hilbertOf(node.x(), node.y()), {splitNet, i}});
+            }
+        }
     }
+    stable_sort(patches.begin(), patches.end(), [](const auto& lhs, const auto& rhs) { return lhs.first < rhs.first; });
 
-#pragma omp parallel for
-    for (unsigned i = 0; i < _nINodes; ++i) {
-        Graph<T>::writeImg(inodes[i], splitNets, image, path, dir);
+    patchFiles.clear();
+    patchLinks.clear();
+    for (unsigned i = 0; i != io::IOModule::ImageShards && !writer.isCapturing(); ++i) {
+        io::IOModule::writeDir(path + "/" + io::IOModule::imageShard(i));
+    }
+#pragma omp parallel for schedule(dynamic, 8)
+    for (unsigned i = 0; i < patches.size(); ++i) {
+        Graph<T>::writeImg(patches[i].second.first, patches[i].second.second, pyramid, path, dir, writer);
+    }
+    //  the linked files must exist
+    bool good = writer.flush();
+    for (const auto& [file, link] : patchLinks) writer.link(file, link);
+    good = writer.flush() && good;
+    printlog(LOG_INFO,
+             "%lu patches, %lu distinct, the others are linked",
+             patchFiles.size() + patchLinks.size(),
+             patchFiles.size());
+
+    //  every output relative to `path`, so that consumers need not list the directories
+    vector<string> outputs;
+    for (const char* table : {".wsc", ".drv", ".snk", ".sel"}) outputs.push_back(base + table + ext);
+    if (graphTables) {
+        for (const char* table : {".nodes", ".edges"}) outputs.push_back(base + table + ext);
     }
+    for (const auto& [digest, file] : patchFiles) outputs.push_back(file.substr(path.size() + 1));
+    for (const auto& [file, link] : patchLinks) outputs.push_back(link.substr(path.size() + 1));
+    writer.write(path + "/" + base + ".manifest", io::manifest(outputs));
 
-    return true;
+    return writer.flush() && good;
 }
 
 }  // namespace db
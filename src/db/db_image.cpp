@@ -4,17 +4,102 @@
 
 using namespace db;
 
+/***** ImageTiles *****/
+
+bool ImageTiles::setup(const unsigned xNum, const unsigned yNum, const string& dir, const size_t capacity) {
+    _xTiles = (xNum + TileSize - 1) / TileSize;
+    _yTiles = (yNum + TileSize - 1) / TileSize;
+    _capacity = capacity;
+    _lru.clear();
+    _hot.clear();
+    return _memory.allocate(static_cast<size_t>(_xTiles) * _yTiles * TileBytes, dir);
+}
+
+void ImageTiles::touch(const unsigned yBegin, const unsigned yEnd, const unsigned xBegin, const unsigned xEnd) {
+    //  the kernel keeps anonymous tiles
+    if (!_memory.isFileBacked() || yBegin >= yEnd || xBegin >= xEnd) return;
+    lock_guard<mutex> lock(_lruMtx);
+    for (unsigned ty = yBegin >> TileBits; ty <= (yEnd - 1) >> TileBits; ++ty) {
+        for (unsigned tx = xBegin >> TileBits; tx <= (xEnd - 1) >> TileBits; ++tx) {
+            const unsigned tile = ty * _xTiles + tx;
+            unordered_map<unsigned, list<unsigned>::iterator>::iterator hi = _hot.find(tile);
+            if (hi != _hot.end()) {
+                _lru.splice(_lru.begin(), _lru, hi->second);
+                continue;
+            }
+            _lru.push_front(tile);
+            _hot.emplace(tile, _lru.begin());
+        }
+    }
+    //  the content of evicted tiles stays in the file, a tile touched again just faults back in
+    while (_hot.size() > _capacity) {
+        const unsigned tile = _lru.back();
+        _lru.pop_back();
+        _hot.erase(tile);
+        _memory.evict(tile * TileBytes, TileBytes);
+    }
+}
+
+/***** Image *****/
+
+Image Image::tiled(const double x,
+                   const double y,
+                   const double xStep,
+                   const double yStep,
+                   const unsigned xNum,
+                   const unsigned yNum,
+                   const string& dir) {
+    Image image(x, y, xStep, yStep, 0, 0);
+    image._xNum = xNum;
+    image._yNum = yNum;
+    image._tiles = make_shared<ImageTiles>();
+    //  256 MB of hot tiles
+    if (!image._tiles->setup(xNum, yNum, dir, 4096)) {
+        printlog(LOG_ERROR, "cannot allocate a %u x %u die image", xNum, yNum);
+        image._xNum = 0;
+        image._yNum = 0;
+        image._tiles.reset();
+    }
+    return image;
+}
+
+size_t Image::hilbertOf(const int x, const int y) const {
+    unsigned px = max(0.0, min<double>(_xNum - 1, floor((x - _x) / _xStep)));
+    unsigned py = max(0.0, min<double>(_yNum - 1, floor((y - _y) / _yStep)));
+    unsigned n = 1;
+    while (n < max(_xNum, _yNum)) n *= 2;
+    size_t d = 0;
+    for (unsigned s = n / 2; s; s /= 2) {
+        const unsigned rx = (px & s) > 0;
+        const unsigned ry = (py & s) > 0;
+        d += static_cast<size_t>(s) * s * ((3 * rx) ^ ry);
+        //  rotate the quadrant
+        if (!ry) {
+            if (rx) {
+                px = n - 1 - px;
+                py = n - 1 - py;
+            }
+            swap(px, py);
+        }
+    }
+    return d;
+}
+
 bool Image::isSeparate(const Pin* p) const { return isSeparate(p->splitNet()); }
 
 void Image::setData(const int y, const int x, const unsigned char s) {
     if (x >= _x && x < _x + _xStep * _xNum && y >= _y && y < _y + _yStep * _yNum) {
-        _data[static_cast<int>((y - _y) / _yStep)][static_cast<int>((x - _x) / _xStep)] |= s;
+        pixel(static_cast<int>((y - _y) / _yStep), static_cast<int>((x - _x) / _xStep)) |= s;
     }
 }
 
-void Image::setRouting(const NetRouting* r, const unsigned base) {
+void Image::setRouting(const NetRouting* r, const unsigned base, const unsigned yBegin, const unsigned yEnd) {
     const int offset = 4 - static_cast<int>(DBModule::Metal);
+    const int rowBegin = yBegin;
+    const int rowEnd = min(yEnd, _yNum);
     for (const NetRouteNode& nrn : r->nodes) {
+        const int row = static_cast<int>((nrn.y() - _y) / _yStep);
+        if (row < rowBegin || row >= rowEnd) continue;
         setDataAt(nrn.y(), nrn.x(), base + max(0, nrn.layer()->rIdx + offset));
     }
     for (const NetRouteSegment& nrs : r->segments) {
@@ -28,37 +113,72 @@ void Image::setRouting(const NetRouting* r, const unsigned base) {
 
         if (fromx == tox) {
             if (fromx < 0 || fromx >= static_cast<int>(_xNum)) continue;
-            const int imax = min(static_cast<int>(_yNum) - 1, max(fromy, toy));
-            for (int i = max(0, min(fromy, toy)); i <= imax; ++i)
-                _data[i][fromx] |= (1 << (base + max(0, fromRIdx + offset)));
+            const int imax = min(rowEnd - 1, max(fromy, toy));
+            for (int i = max(rowBegin, min(fromy, toy)); i <= imax; ++i)
+                pixel(i, fromx) |= (1 << (base + max(0, fromRIdx + offset)));
         } else if (fromy == toy) {
-            if (fromy < 0 || fromy >= static_cast<int>(_yNum)) continue;
+            if (fromy < rowBegin || fromy >= rowEnd) continue;
             const int imax = min(static_cast<int>(_xNum) - 1, max(fromx, tox));
             for (int i = max(0, min(fromx, tox)); i <= imax; ++i)
-                _data[fromy][i] |= (1 << (base + max(0, fromRIdx + offset)));
+                pixel(fromy, i) |= (1 << (base + max(0, fromRIdx + offset)));
         }
     }
 }
 
 void Image::setRouting(const Pin* p, const unsigned base) { return setRouting(p->splitNet(), base); }
 
-void Image::encode(const string& filename, const unsigned dir) const {
+vector<unsigned char> Image::raw(const unsigned dir) const {
     vector<unsigned char> image(_xNum * _yNum);
     for (unsigned i = 0; i != _yNum; ++i) {
         for (unsigned j = 0; j != _xNum; ++j) {
             switch (dir) {
                 case 0:
-                    image[(i * _xNum + j)] = _data[i][j];
+                    image[(i * _xNum + j)] = data(i, j);
                     break;
                 case 1:
-                    image[(j * _yNum + i)] = _data[i][j];
+                    image[(j * _yNum + i)] = data(i, j);
                     break;
                 default:
                     printlog(LOG_ERROR, "unidentified dir %d", dir);
-                    return;
+                    return {};
             }
         }
     }
+    return image;
+}
+
+ImageDigest Image::digest(const vector<unsigned char>& raw) {
+    //  two independent 64-bit lanes over 8-byte words, finalized like MurmurHash3
+    const auto mix = [](uint64_t h) {
+        h ^= h >> 33;
+        h *= 0xff51afd7ed558ccdull;
+        h ^= h >> 33;
+        h *= 0xc4ceb9fe1a85ec53ull;
+        return h ^ (h >> 33);
+    };
+    ImageDigest d;
+    d.lo = 0x9e3779b97f4a7c15ull ^ raw.size();
+    d.hi = 0xc2b2ae3d27d4eb4full ^ (static_cast<uint64_t>(raw.size()) << 1);
+    size_t i = 0;
+    for (; i + 8 <= raw.size(); i += 8) {
+        uint64_t word;
+        memcpy(&word, &raw[i], 8);
+        d.lo = (d.lo ^ word) * 0x100000001b3ull;
+        d.lo ^= d.lo >> 29;
+        d.hi = (d.hi ^ (word * 0x87c37b91114253d5ull)) * 0x4cf5ad432745937full;
+        d.hi ^= d.hi >> 31;
+    }
+    for (; i != raw.size(); ++i) {
+        d.lo = (d.lo ^ raw[i]) * 0x100000001b3ull;
+        d.hi = (d.hi ^ raw[i]) * 0x4cf5ad432745937full;
+    }
+    d.lo = mix(d.lo);
+    d.hi = mix(d.hi ^ d.lo);
+    return d;
+}
+
+string Image::png(const vector<unsigned char>& image, const unsigned dir) const {
+    if (image.size() != static_cast<size_t>(_xNum) * _yNum) return "";
 
     lodepng::State state;
     state.info_raw.colortype = LCT_GREY;
@@ -77,13 +197,19 @@ void Image::encode(const string& filename, const unsigned dir) const {
             break;
         default:
             printlog(LOG_ERROR, "unidentified dir %d", dir);
-            return;
+            return "";
     }
     if (error) {
         printlog(LOG_ERROR, "encoder error %u: %s", error, lodepng_error_text(error));
-        return;
+        return "";
     }
-    error = lodepng::save_file(buffer, filename);
+    return string(buffer.begin(), buffer.end());
+}
+
+void Image::encode(const string& filename, const unsigned dir) const {
+    const string buffer = png(raw(dir), dir);
+    if (buffer.empty()) return;
+    const unsigned error = lodepng::save_file(vector<unsigned char>(buffer.begin(), buffer.end()), filename);
     switch (error) {
         case 0:
             return;
@@ -96,9 +222,157 @@ void Image::encode(const string& filename, const unsigned dir) const {
     }
 }
 
-Image& Image::operator+=(const Image& rhs) {
-    for (unsigned i = 0; i != _yNum; ++i) {
-        for (unsigned j = 0; j != _xNum; ++j) _data[i][j] |= rhs._data[i][j];
+void ImageDensity::integrate(unsigned* table) const {
+    const size_t w = _xNum + 1;
+#pragma omp parallel for
+    for (unsigned y = 1; y <= _yNum; ++y) {
+        unsigned* row = table + y * w;
+        for (unsigned x = 1; x <= _xNum; ++x) row[x] += row[x - 1];
+    }
+    for (unsigned y = 2; y <= _yNum; ++y) {
+        unsigned* row = table + y * w;
+        const unsigned* above = row - w;
+#pragma omp simd
+        for (unsigned x = 1; x <= _xNum; ++x) row[x] += above[x];
+    }
+}
+
+bool ImageDensity::setup(const Image& image, const vector<Cell*>& cells, const string& dir) {
+    _x = image.xOrigin();
+    _y = image.yOrigin();
+    _xStep = image.xStep();
+    _yStep = image.yStep();
+    _xNum = image.xNum();
+    _yNum = image.yNum();
+    const size_t w = _xNum + 1;
+    const size_t size = (_yNum + 1) * w * sizeof(unsigned);
+    if (!_routing.allocate(size, dir) || !_placement.allocate(size, dir)) return false;
+    unsigned* routing = reinterpret_cast<unsigned*>(_routing.data());
+    unsigned* placement = reinterpret_cast<unsigned*>(_placement.data());
+
+    //  a band of rows per tile row of the image
+    const unsigned nBands = (_yNum + ImageTiles::TileSize - 1) / ImageTiles::TileSize;
+#pragma omp parallel for schedule(dynamic)
+    for (unsigned b = 0; b < nBands; ++b) {
+        const unsigned yEnd = min((b + 1) * ImageTiles::TileSize, _yNum);
+        image.touch(b * ImageTiles::TileSize, yEnd, 0, _xNum);
+        for (unsigned y = b * ImageTiles::TileSize; y < yEnd; ++y) {
+            unsigned* row = routing + (y + 1) * w + 1;
+            for (unsigned x = 0; x != _xNum; ++x) {
+                row[x] = __builtin_popcount(image.data(y, x) & ((1 << NumLayers) - 1));
+            }
+        }
+    }
+    integrate(routing);
+
+    //  a cell covers the pixels whose centers it contains, marked at the corners of its pixel range
+    const auto pixel = [](const int v, const double origin, const double step, const unsigned num) {
+        return static_cast<size_t>(max(0.0, min<double>(num, ceil((v - origin) / step - 0.5))));
+    };
+    for (const Cell* cell : cells) {
+        if (!cell->placed()) continue;
+        const size_t lx = pixel(cell->lx(), _x, _xStep, _xNum);
+        const size_t hx = pixel(cell->hx(), _x, _xStep, _xNum);
+        const size_t ly = pixel(cell->ly(), _y, _yStep, _yNum);
+        const size_t hy = pixel(cell->hy(), _y, _yStep, _yNum);
+        if (lx == hx || ly == hy) continue;
+        ++placement[ly * w + lx];
+        --placement[ly * w + hx];
+        --placement[hy * w + lx];
+        ++placement[hy * w + hx];
+    }
+    //  the first integration counts the cells over each pixel, shifted into place as covered or not
+    for (unsigned x = 1; x <= _xNum; ++x) placement[x] += placement[x - 1];
+    for (size_t y = 1; y <= _yNum; ++y) {
+        placement[y * w] += placement[(y - 1) * w];
+        for (unsigned x = 1; x <= _xNum; ++x) {
+            placement[y * w + x] +=
+                placement[y * w + x - 1] + placement[(y - 1) * w + x] - placement[(y - 1) * w + x - 1];
+        }
+    }
+    for (size_t y = _yNum; y; --y) {
+        for (size_t x = _xNum; x; --x) placement[y * w + x] = static_cast<int>(placement[(y - 1) * w + x - 1]) > 0;
+    }
+    fill(placement, placement + w, 0);
+    for (size_t y = 1; y <= _yNum; ++y) placement[y * w] = 0;
+    integrate(placement);
+    return true;
+}
+
+unsigned ImageDensity::sum(
+    const unsigned* table, const int x, const int y, const unsigned radius, unsigned& area) const {
+    const int cx = static_cast<int>(floor((x - _x) / _xStep));
+    const int cy = static_cast<int>(floor((y - _y) / _yStep));
+    const int r = radius;
+    const unsigned lx = max(0, min<int>(_xNum, cx - r));
+    const unsigned hx = max(0, min<int>(_xNum, cx + r + 1));
+    const unsigned ly = max(0, min<int>(_yNum, cy - r));
+    const unsigned hy = max(0, min<int>(_yNum, cy + r + 1));
+    area = (hx - lx) * (hy - ly);
+    const size_t w = _xNum + 1;
+    return table[hy * w + hx] - table[ly * w + hx] - table[hy * w + lx] + table[ly * w + lx];
+}
+
+double ImageDensity::routing(const int x, const int y, const unsigned radius) const {
+    unsigned area = 0;
+    const unsigned used = sum(reinterpret_cast<const unsigned*>(_routing.data()), x, y, radius, area);
+    return area ? used / static_cast<double>(area * NumLayers) : 0.0;
+}
+
+double ImageDensity::placement(const int x, const int y, const unsigned radius) const {
+    unsigned area = 0;
+    const unsigned covered = sum(reinterpret_cast<const unsigned*>(_placement.data()), x, y, radius, area);
+    return area ? covered / static_cast<double>(area) : 0.0;
+}
+
+bool ImagePyramid::setup(const Image& image, const unsigned nLevels, const string& dir) {
+    _image = &image;
+    _levels.assign(1, Level());
+    _levels[0].xNum = image.xNum();
+    _levels[0].yNum = image.yNum();
+    size_t size = 0;
+    for (unsigned l = 1; l < nLevels; ++l) {
+        Level level;
+        level.xNum = (_levels.back().xNum + 1) / 2;
+        level.yNum = (_levels.back().yNum + 1) / 2;
+        level.offset = size;
+        size += static_cast<size_t>(level.xNum) * level.yNum;
+        _levels.push_back(level);
+    }
+    if (!_data.allocate(size, dir)) return false;
+
+    for (unsigned l = 1; l < nLevels; ++l) {
+        const Level& fine = _levels[l - 1];
+        //  a band of fine rows per tile row of the image
+        const unsigned nBands = (fine.yNum + ImageTiles::TileSize - 1) / ImageTiles::TileSize;
+#pragma omp parallel for schedule(dynamic)
+        for (unsigned b = 0; b < nBands; ++b) {
+            const unsigned fyEnd = min((b + 1) * ImageTiles::TileSize, fine.yNum);
+            if (l == 1) image.touch(b * ImageTiles::TileSize, fyEnd, 0, fine.xNum);
+            for (unsigned fy = b * ImageTiles::TileSize; fy < fyEnd; ++fy) {
+                unsigned char* row = &at(l, fy / 2, 0);
+                for (unsigned fx = 0; fx != fine.xNum; ++fx) row[fx / 2] |= data(l - 1, fy, fx);
+            }
+        }
+    }
+    return true;
+}
+
+Image ImagePyramid::crop(const int x, const int y, const unsigned level, const unsigned w, const unsigned h) const {
+    const Level& lvl = _levels[level];
+    const double xStep = _image->xStep() * (1 << level);
+    const double yStep = _image->yStep() * (1 << level);
+    const int xIdx = static_cast<int>(floor((x - _image->xOrigin()) / xStep)) - static_cast<int>(w / 2);
+    const int yIdx = static_cast<int>(floor((y - _image->yOrigin()) / yStep)) - static_cast<int>(h / 2);
+    Image patch(_image->xOrigin() + xIdx * xStep, _image->yOrigin() + yIdx * yStep, xStep, yStep, w, h);
+    const int iBegin = max(0, -yIdx);
+    const int iEnd = min<int>(h, static_cast<int>(lvl.yNum) - yIdx);
+    const int jBegin = max(0, -xIdx);
+    const int jEnd = min<int>(w, static_cast<int>(lvl.xNum) - xIdx);
+    if (iBegin >= iEnd || jBegin >= jEnd) return patch;
+    if (!level) _image->touch(yIdx + iBegin, yIdx + iEnd, xIdx + jBegin, xIdx + jEnd);
+    for (int i = iBegin; i < iEnd; ++i) {
+        for (int j = jBegin; j < jEnd; ++j) patch._data[i][j] = data(level, yIdx + i, xIdx + j);
     }
-    return *this;
+    return patch;
 }
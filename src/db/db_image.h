@@ -1,9 +1,56 @@
 #ifndef _DB_IMAGE_
 #define _DB_IMAGE_
 
+#include <memory>
+
+#include "../io/utils.h"
+
 namespace db {
+//  Pixels of a die image in TileSize x TileSize tiles, one after the other in scratch memory, so that a window of
+//  the die is a few contiguous blocks. Tiles are allocated when first touched. When the scratch memory is file
+//  backed, only the `capacity` most recently touched tiles are kept resident.
+class ImageTiles {
+private:
+    static constexpr unsigned TileBits = 8;
+
+    unsigned _xTiles = 0;
+    unsigned _yTiles = 0;
+    size_t _capacity = 0;
+    io::ScratchMemory _memory;
+    mutex _lruMtx;
+    list<unsigned> _lru;
+    unordered_map<unsigned, list<unsigned>::iterator> _hot;
+
+public:
+    static constexpr unsigned TileSize = 1 << TileBits;
+    static constexpr size_t TileBytes = static_cast<size_t>(TileSize) * TileSize;
+
+    bool setup(const unsigned xNum, const unsigned yNum, const string& dir, const size_t capacity);
+
+    unsigned char& at(const unsigned y, const unsigned x) const {
+        const size_t tile = static_cast<size_t>(y >> TileBits) * _xTiles + (x >> TileBits);
+        return reinterpret_cast<unsigned char*>(
+            _memory.data())[tile * TileBytes + ((y & (TileSize - 1)) << TileBits) + (x & (TileSize - 1))];
+    }
+    //  mark the tiles of rows [yBegin, yEnd) and columns [xBegin, xEnd) as the most recently used
+    void touch(const unsigned yBegin, const unsigned yEnd, const unsigned xBegin, const unsigned xEnd);
+};
+
+//  128-bit content hash of the pixels of an image
+struct ImageDigest {
+    uint64_t lo = 0;
+    uint64_t hi = 0;
+
+    bool operator==(const ImageDigest& rhs) const { return lo == rhs.lo && hi == rhs.hi; }
+};
+
+struct ImageDigestHash {
+    size_t operator()(const ImageDigest& d) const { return d.lo; }
+};
+
 class Image {
     friend class Database;
+    friend class ImagePyramid;
 
 private:
     double _x = 0;
@@ -13,6 +60,10 @@ private:
     unsigned _xNum = 99;
     unsigned _yNum = 99;
     vector<vector<unsigned char>> _data;
+    //  the pixels of a die image, instead of `_data`
+    shared_ptr<ImageTiles> _tiles;
+
+    unsigned char& pixel(const unsigned y, const unsigned x) { return _tiles ? _tiles->at(y, x) : _data[y][x]; }
 
 public:
     Image(const double x = 0,
@@ -29,13 +80,29 @@ public:
           _yNum(yNum),
           _data(yNum, vector<unsigned char>(xNum, 0)) {}
 
+    //  an image in tiles, kept in a scratch file under `dir` when it is not empty
+    static Image tiled(const double x,
+                       const double y,
+                       const double xStep,
+                       const double yStep,
+                       const unsigned xNum,
+                       const unsigned yNum,
+                       const string& dir);
+
     double xOrigin() const { return _x; }
     double yOrigin() const { return _y; }
     double xStep() const { return _xStep; }
     double yStep() const { return _yStep; }
     unsigned xNum() const { return _xNum; }
     unsigned yNum() const { return _yNum; }
-    unsigned char data(const unsigned y, const unsigned x) const { return _data[y][x]; }
+    unsigned char data(const unsigned y, const unsigned x) const { return _tiles ? _tiles->at(y, x) : _data[y][x]; }
+    //  about to access rows [yBegin, yEnd) and columns [xBegin, xEnd)
+    void touch(const unsigned yBegin, const unsigned yEnd, const unsigned xBegin, const unsigned xEnd) const {
+        if (_tiles) _tiles->touch(yBegin, min(yEnd, _yNum), xBegin, min(xEnd, _xNum));
+    }
+    //  position of the pixel at (x, y), clamped to the image, along a Hilbert curve over the image.
+    //  The curve covers every aligned power-of-2 square, tiles included, before it leaves it.
+    size_t hilbertOf(const int x, const int y) const;
     bool isSeparate(const Rectangle* rect) const {
         return rect->lx() >= _x + _xStep * _xNum || rect->hx() <= _x || rect->ly() >= _y + _yStep * _yNum ||
                rect->hy() <= _y;
@@ -45,11 +112,80 @@ public:
     void setDataAt(const int y, const int x, const int rIdx) {
         if (rIdx >= 0 && rIdx < 8) setData(y, x, 1 << rIdx);
     }
-    void setRouting(const NetRouting* r, const unsigned base);
+    //  only rows [yBegin, yEnd) are written, so that disjoint row ranges can be drawn concurrently
+    void setRouting(const NetRouting* r,
+                    const unsigned base,
+                    const unsigned yBegin = 0,
+                    const unsigned yEnd = numeric_limits<unsigned>::max());
     void setRouting(const Pin* p, const unsigned base);
+    //  the pixels in rows, transposed for `dir` 1
+    vector<unsigned char> raw(const unsigned dir) const;
+    static ImageDigest digest(const vector<unsigned char>& raw);
+    //  the PNG file of `raw`, empty on errors
+    string png(const vector<unsigned char>& raw, const unsigned dir) const;
     void encode(const string& filename, const unsigned dir) const;
+};
+
+//  OR-pooled levels of the full-die image, level l is 2^l times coarser. Level 0 is the image itself and the
+//  coarser levels are stored one after the other, so that a patch at any scale is a crop.
+class ImagePyramid {
+private:
+    struct Level {
+        unsigned xNum = 0;
+        unsigned yNum = 0;
+        size_t offset = 0;
+    };
+
+    const Image* _image = nullptr;
+    vector<Level> _levels;
+    io::ScratchMemory _data;
+
+    unsigned char& at(const unsigned level, const unsigned y, const unsigned x) const {
+        return reinterpret_cast<unsigned char*>(
+            _data.data())[_levels[level].offset + static_cast<size_t>(y) * _levels[level].xNum + x];
+    }
+    unsigned char data(const unsigned level, const unsigned y, const unsigned x) const {
+        return level ? at(level, y, x) : _image->data(y, x);
+    }
+
+public:
+    //  the coarser levels are in scratch memory under `dir` when it is not empty
+    bool setup(const Image& image, const unsigned nLevels, const string& dir);
+
+    const Image& image() const { return *_image; }
+    unsigned numLevels() const { return _levels.size(); }
+    //  `w` x `h` pixels of `level` centered on the pixel at (x, y), 0 off the die
+    Image crop(const int x, const int y, const unsigned level, const unsigned w, const unsigned h) const;
+};
+
+//  Summed-area tables over the full-die image, so that the density of any window is four lookups.
+//  Sums wrap modulo 2^32, which is still exact for windows of less than 2^32.
+class ImageDensity {
+private:
+    static constexpr unsigned NumLayers = 4;
+
+    double _x = 0;
+    double _y = 0;
+    double _xStep = 1;
+    double _yStep = 1;
+    unsigned _xNum = 0;
+    unsigned _yNum = 0;
+    //  (yNum + 1) x (xNum + 1) in rows, the first row and column are 0
+    io::ScratchMemory _routing;
+    io::ScratchMemory _placement;
+
+    void integrate(unsigned* table) const;
+    //  pixels and sum of `table` in the window of `radius` pixels around (x, y), clipped to the die
+    unsigned sum(const unsigned* table, const int x, const int y, const unsigned radius, unsigned& area) const;
+
+public:
+    //  the tables are in scratch memory under `dir` when it is not empty
+    bool setup(const Image& image, const vector<Cell*>& cells, const string& dir);
 
-    Image& operator+=(const Image& rhs);
+    //  fraction of the routing layers below the split layer used in the window
+    double routing(const int x, const int y, const unsigned radius) const;
+    //  fraction of the window covered by cells
+    double placement(const int x, const int y, const unsigned radius) const;
 };
 }  // namespace db
 
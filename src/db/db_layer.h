@@ -45,6 +45,11 @@ public:
     int offset = -1;
     int width = -1;
     int spacing = -1;
+    //  ohm per square for route layer, ohm per cut for cut layer
+    double resistance = 0.0;
+    //  pF per square micron and pF per micron of edge, for route layer
+    double capacitance = 0.0;
+    double edgeCapacitance = 0.0;
     Track track;
 
     Layer(const string& name = "", const char type = 'x') : _name(name), _type(type) {}
@@ -0,0 +1,49 @@
+#include "db.h"
+using namespace db;
+
+/***** NamePool *****/
+
+const char* NamePool::store(const string_view name) {
+    const size_t size = name.size() + 1;
+    char* buffer = nullptr;
+    if (size > BlockSize) {
+        //  oversized names get a dedicated block
+        _blocks.emplace_back(new char[size]);
+        _blockUsed = BlockSize;
+        buffer = _blocks.back().get();
+    } else {
+        if (_blockUsed + size > BlockSize) {
+            _blocks.emplace_back(new char[BlockSize]);
+            _blockUsed = 0;
+        }
+        buffer = _blocks.back().get() + _blockUsed;
+        _blockUsed += size;
+    }
+    memcpy(buffer, name.data(), name.size());
+    buffer[name.size()] = '\0';
+    return buffer;
+}
+
+unsigned NamePool::intern(const string_view name) {
+    unordered_map<string_view, unsigned>::const_iterator mi = _ids.find(name);
+    if (mi != _ids.end()) return mi->second;
+
+    const string_view stored(store(name), name.size());
+    const unsigned id = _names.size();
+    _names.push_back(stored);
+    _ids.emplace(stored, id);
+    return id;
+}
+
+unsigned NamePool::find(const string_view name) const {
+    unordered_map<string_view, unsigned>::const_iterator mi = _ids.find(name);
+    if (mi == _ids.end()) return None;
+    return mi->second;
+}
+
+void NamePool::clear() {
+    _ids.clear();
+    _names.clear();
+    _blocks.clear();
+    _blockUsed = BlockSize;
+}
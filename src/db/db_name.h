@@ -0,0 +1,34 @@
+#ifndef _DB_NAME_H_
+#define _DB_NAME_H_
+
+#include <memory>
+#include <string_view>
+
+namespace db {
+//  Interned storage for database object names.
+//  Every name is stored once in a block arena; the returned views stay valid until `clear()`
+//  and are NUL-terminated so that `data()` can be passed to printlog directly.
+class NamePool {
+private:
+    static constexpr size_t BlockSize = 64 * 1024;
+
+    vector<unique_ptr<char[]>> _blocks;
+    size_t _blockUsed = BlockSize;
+    vector<string_view> _names;
+    unordered_map<string_view, unsigned> _ids;
+
+    const char* store(const string_view name);
+
+public:
+    static constexpr unsigned None = UINT_MAX;
+
+    unsigned intern(const string_view name);
+    unsigned find(const string_view name) const;
+    string_view name(const unsigned id) const { return _names[id]; }
+    unsigned size() const { return _names.size(); }
+
+    void clear();
+};
+}  // namespace db
+
+#endif
@@ -1,3 +1,5 @@
+#include <numeric>
+
 #include "db.h"
 using namespace db;
 
@@ -59,7 +61,7 @@ void NetRouting::addNode(const NetRouteNode& n, const bool updatePin) {
                      n.layer()->name().c_str(),
                      n.x(),
                      n.y(),
-                     _name.c_str());
+                     _name.data());
         } else {
             const boostBox box({n.x(), n.y()}, {n.x(), n.y()});
             vector<pair<boostBox, Pin*>> results;
@@ -99,7 +101,7 @@ void NetRouting::addWire(const NetRouteNode& fromNode, const NetRouteNode& toNod
                  fromNode.layer()->name().c_str(),
                  fromNode.x(),
                  fromNode.y(),
-                 _name.c_str());
+                 _name.data());
         return;
     }
 
@@ -109,7 +111,7 @@ void NetRouting::addWire(const NetRouteNode& fromNode, const NetRouteNode& toNod
                  toNode.layer()->name().c_str(),
                  toNode.x(),
                  toNode.y(),
-                 _name.c_str());
+                 _name.data());
         return;
     }
 
@@ -298,7 +300,7 @@ double Net::setCapacitance(const double default_capacitance, const double defaul
         if (_capacitance <= 0)
             printlog(LOG_ERROR,
                      "Sink net %s has infeasible cap %f with default cap %f",
-                     name().c_str(),
+                     name().data(),
                      _capacitance,
                      default_capacitance);
         return _capacitance;
@@ -465,6 +467,21 @@ bool Net::isLoop(Net* inet, const Net* onet) {
 
 /***** SplitNet *****/
 
+namespace {
+string eraseBackslashes(string name) {
+    name.erase(remove(name.begin(), name.end(), '\\'), name.end());
+    return name;
+}
+}  // namespace
+
+string SplitNet::nameOf(const Net* parent, const unsigned comp) {
+    return eraseBackslashes(string(parent->name()) + "_split_" + to_string(comp));
+}
+
+string SplitNet::nameOf(const Pin* pin) {
+    return eraseBackslashes(pin->cell ? string(pin->cell->name()) + "_" + pin->type->name() : pin->iopin->name);
+}
+
 void SplitNet::addUpVia(const NetRouteNode& n) {
     for (const NetRouteNode& node : upVias) {
         if (node == n) {
@@ -474,30 +491,225 @@ void SplitNet::addUpVia(const NetRouteNode& n) {
     upVias.push_back(n);
 }
 
-void SplitNet::write(
-    ostream& os, const string& design, const Rectangle& die, const Point& pitch, const unsigned dir) const {
-    for (unsigned viaIdx = 0; viaIdx != upVias.size(); ++viaIdx) {
-        const NetRouteUpNode& via = upVias[viaIdx];
-        os << design << ',' << _parent->name() << ',' << _name << ',' << viaIdx << ','
-           << via[dir] / static_cast<double>(pitch[dir]) << ',' << via[1 - dir] / static_cast<double>(pitch[1 - dir])
-           << ',' << (via[dir] - die[dir].lo()) / static_cast<double>(die[dir].range()) << ','
-           << (via[1 - dir] - die[1 - dir].lo()) / static_cast<double>(die[1 - dir].range()) << ',' << via.dirnn()
-           << ',' << via.dirnp(dir) << ',' << via.dirnp(1 - dir) << ',' << via.dirpp() << ',' << _numOPins << ',';
-        if (_upPin) {
-            os << "1,";
-        } else {
-            os << "0,";
-        }
-        os << pitchLen() << ',' << numVias() << ',' << pitchLen(DBModule::Metal - 1);
-        for (int i = static_cast<int>(DBModule::Metal) - 2; i != static_cast<int>(DBModule::Metal) - 5; --i) {
-            if (i >= 0) {
-                os << ',' << numVias(i) << ',' << pitchLen(i);
-            } else {
-                os << ',' << 0 << ',' << 0;
+void SplitNet::extractRC(const vector<Layer*>& cLayers, const double dbuMicron, const double capacitanceUnit) {
+    const unsigned nNodes = nodes.size();
+    vector<double> segRes(segments.size(), 0.0);
+    vector<double> nodeCaps(nNodes, 0.0);
+    _wireRes = 0;
+    _wireCap = 0;
+    for (unsigned s = 0; s != segments.size(); ++s) {
+        const NetRouteSegment& segment = segments[s];
+        const Layer* fromLayer = nodes[segment.fromNode].layer();
+        const Layer* toLayer = nodes[segment.toNode].layer();
+        double res = 0;
+        double cap = 0;
+        switch (segment.dir()) {
+            case 'P':
+                break;
+            case 'U':
+            case 'D': {
+                const int cIdx = min(fromLayer->rIdx, toLayer->rIdx);
+                if (cIdx >= 0 && cIdx < static_cast<int>(cLayers.size()) && cLayers[cIdx]) {
+                    res = cLayers[cIdx]->resistance;
+                }
+                break;
+            }
+            default: {
+                const double len = segment.len() / dbuMicron;
+                const double width = (segment.width() > 0 ? segment.width() : fromLayer->width) / dbuMicron;
+                if (width > 0) res = fromLayer->resistance * len / width;
+                cap = fromLayer->capacitance * len * width + 2 * fromLayer->edgeCapacitance * len;
+                break;
+            }
+        }
+        //  pi model
+        segRes[s] = res;
+        nodeCaps[segment.fromNode] += cap / 2;
+        nodeCaps[segment.toNode] += cap / 2;
+        _wireRes += res;
+        _wireCap += cap;
+    }
+
+    _loadCap = _wireCap;
+    vector<unsigned> sinkNodes;
+    for (const Pin* pin : pins) {
+        if (!pin->isSink()) continue;
+        const double cap = pin->capacitance() * capacitanceUnit;
+        _loadCap += cap;
+        for (unsigned i = 0; i != nNodes; ++i) {
+            if (nodes[i].pin() == pin) {
+                nodeCaps[i] += cap;
+                sinkNodes.push_back(i);
+                break;
             }
         }
-        os << endl;
     }
+
+    //  topology in compressed rows, built from the segments since the nodes copied from the parent net
+    //  still carry its adjacencies
+    vector<unsigned> adjBegin(nNodes + 1, 0);
+    for (const NetRouteSegment& segment : segments) {
+        ++adjBegin[segment.fromNode + 1];
+        ++adjBegin[segment.toNode + 1];
+    }
+    partial_sum(adjBegin.begin(), adjBegin.end(), adjBegin.begin());
+    vector<unsigned> adjSegs(adjBegin[nNodes]);
+    {
+        vector<unsigned> adjPos(adjBegin.begin(), adjBegin.end() - 1);
+        for (unsigned s = 0; s != segments.size(); ++s) {
+            adjSegs[adjPos[segments[s].fromNode]++] = s;
+            adjSegs[adjPos[segments[s].toNode]++] = s;
+        }
+    }
+
+    //  Elmore delays of all nodes from `root`, on the DFS tree when the routing has loops
+    vector<unsigned> order;
+    vector<int> parentSeg(nNodes);
+    vector<double> downCaps(nNodes);
+    vector<double> delays(nNodes);
+    const auto elmore = [&](const unsigned root) {
+        order.clear();
+        fill(parentSeg.begin(), parentSeg.end(), -2);
+        parentSeg[root] = -1;
+        order.push_back(root);
+        for (unsigned o = 0; o != order.size(); ++o) {
+            const unsigned n = order[o];
+            for (unsigned a = adjBegin[n]; a != adjBegin[n + 1]; ++a) {
+                const NetRouteSegment& segment = segments[adjSegs[a]];
+                const unsigned m = segment.fromNode == n ? segment.toNode : segment.fromNode;
+                if (parentSeg[m] != -2) continue;
+                parentSeg[m] = adjSegs[a];
+                order.push_back(m);
+            }
+        }
+        fill(downCaps.begin(), downCaps.end(), 0.0);
+        fill(delays.begin(), delays.end(), 0.0);
+        for (vector<unsigned>::const_reverse_iterator oi = order.rbegin(); oi != order.rend(); ++oi) {
+            downCaps[*oi] += nodeCaps[*oi];
+            if (parentSeg[*oi] < 0) continue;
+            const NetRouteSegment& segment = segments[parentSeg[*oi]];
+            downCaps[segment.fromNode == *oi ? segment.toNode : segment.fromNode] += downCaps[*oi];
+        }
+        for (const unsigned n : order) {
+            if (parentSeg[n] < 0) continue;
+            const NetRouteSegment& segment = segments[parentSeg[n]];
+            const unsigned up = segment.fromNode == n ? segment.toNode : segment.fromNode;
+            delays[n] = delays[up] + segRes[parentSeg[n]] * downCaps[n];
+        }
+    };
+    const auto nodeIdx = [&](const NetRouteNode& node) -> int {
+        for (unsigned i = 0; i != nNodes; ++i) {
+            if (nodes[i] == node) return i;
+        }
+        return -1;
+    };
+
+    elmores.assign(upVias.size(), 0.0);
+    if (isSource()) {
+        int root = -1;
+        for (unsigned i = 0; i != nNodes && root < 0; ++i) {
+            if (nodes[i].pin() == _iPin) root = i;
+        }
+        if (root < 0) return;
+        elmore(root);
+        for (unsigned v = 0; v != upVias.size(); ++v) {
+            const int via = nodeIdx(upVias[v]);
+            if (via >= 0) elmores[v] = delays[via];
+        }
+    } else {
+        for (unsigned v = 0; v != upVias.size(); ++v) {
+            const int via = nodeIdx(upVias[v]);
+            if (via < 0) continue;
+            elmore(via);
+            for (const unsigned sink : sinkNodes) elmores[v] = max(elmores[v], delays[sink]);
+        }
+    }
+}
+
+vector<Column<const SplitNet*>> SplitNet::netColumns() {
+    using Row = const SplitNet*;
+    vector<Column<Row>> columns = {
+        {"PARENT", [](Row n) { return n->_parent->name(); }},
+        {"NAME", [](Row n) { return n->name(); }},
+        {"SINK_COUNT", [](Row n) { return n->numOPins(); }},
+        {"UP_PIN", [](Row n) { return n->upPin() ? 1 : 0; }},
+        {"WL", [](Row n) { return n->pitchLen(); }},
+        {"VIAS", [](Row n) { return n->numVias(); }},
+        {"WL_M4", [](Row n) { return n->pitchLen(DBModule::Metal - 1); }},
+    };
+    //  the three layers below the split
+    for (unsigned k = 3; k; --k) {
+        const int i = static_cast<int>(DBModule::Metal) - 5 + k;
+        const string vias = "VIAS_V" + to_string(k) + to_string(k + 1);
+        const string wl = "WL_M" + to_string(k);
+        if (i >= 0) {
+            columns.emplace_back(vias, [i](Row n) { return n->numVias(i); });
+            columns.emplace_back(wl, [i](Row n) { return n->pitchLen(i); });
+        } else {
+            columns.emplace_back(vias, [](Row n) { return 0; });
+            columns.emplace_back(wl, [](Row n) { return 0.0; });
+        }
+    }
+    columns.emplace_back("RC_RES", [](Row n) { return n->_wireRes; });
+    columns.emplace_back("RC_WIRE_CAP", [](Row n) { return n->_wireCap; });
+    columns.emplace_back("RC_LOAD_CAP", [](Row n) { return n->_loadCap; });
+    return columns;
+}
+
+vector<Column<SplitNet::ViaRow>> SplitNet::columns(const string& design,
+                                                   const Rectangle& die,
+                                                   const Point& pitch,
+                                                   const unsigned dir,
+                                                   const ImageDensity& density) {
+    using Row = const ViaRow&;
+    const double px = pitch[dir];
+    const double py = pitch[1 - dir];
+    const int lx = die[dir].lo();
+    const int ly = die[1 - dir].lo();
+    const double rx = die[dir].range();
+    const double ry = die[1 - dir].range();
+    //  the columns of the split net are those of its vias
+    vector<Column<ViaRow>> netColumns;
+    for (const Column<const SplitNet*>& column : SplitNet::netColumns()) {
+        netColumns.emplace_back(column.name, column.type, [extract = column.extract](Row v) { return extract(v.net); });
+    }
+    vector<Column<ViaRow>> columns = {
+        {"DESIGN", [design](Row v) { return design; }},
+        netColumns[0],
+        netColumns[1],
+        {"VIA_IDX", [](Row v) { return v.viaIdx; }},
+        {"VIA_ABSOLUTE_X", [dir, px](Row v) { return v.net->upVias[v.viaIdx][dir] / px; }},
+        {"VIA_ABSOLUTE_Y", [dir, py](Row v) { return v.net->upVias[v.viaIdx][1 - dir] / py; }},
+        {"VIA_RELATIVE_X", [dir, lx, rx](Row v) { return (v.net->upVias[v.viaIdx][dir] - lx) / rx; }},
+        {"VIA_RELATIVE_Y", [dir, ly, ry](Row v) { return (v.net->upVias[v.viaIdx][1 - dir] - ly) / ry; }},
+        {"DIR_NN", [](Row v) { return v.net->upVias[v.viaIdx].dirnn(); }},
+        {"DIR_NP", [dir](Row v) { return v.net->upVias[v.viaIdx].dirnp(dir); }},
+        {"DIR_PN", [dir](Row v) { return v.net->upVias[v.viaIdx].dirnp(1 - dir); }},
+        {"DIR_PP", [](Row v) { return v.net->upVias[v.viaIdx].dirpp(); }},
+    };
+    columns.insert(columns.end(), netColumns.begin() + 2, netColumns.end());
+    columns.emplace_back("RC_ELMORE", [](Row v) {
+        return v.viaIdx < v.net->elmores.size() ? v.net->elmores[v.viaIdx] : 0.0;
+    });
+    //  around the via, in the windows of its images
+    const ImageDensity* d = &density;
+    for (unsigned j = 1; j <= 4; j *= 2) {
+        columns.emplace_back("ROUTING_DENSITY_" + to_string(j), [d, j](Row v) {
+            const NetRouteUpNode& via = v.net->upVias[v.viaIdx];
+            return d->routing(via.x(), via.y(), 50 * j - 1);
+        });
+    }
+    for (unsigned j = 1; j <= 4; j *= 2) {
+        columns.emplace_back("PLACEMENT_DENSITY_" + to_string(j), [d, j](Row v) {
+            const NetRouteUpNode& via = v.net->upVias[v.viaIdx];
+            return d->placement(via.x(), via.y(), 50 * j - 1);
+        });
+    }
+    return columns;
+}
+
+void SplitNet::write(io::RowGroup& rows, const vector<Column<ViaRow>>& columns) const {
+    for (unsigned viaIdx = 0; viaIdx != upVias.size(); ++viaIdx) addRow(rows, columns, {this, viaIdx});
 }
 
 bool SplitNet::isSeparate(const SplitNet* m, const SplitNet* n) {
@@ -506,11 +718,11 @@ bool SplitNet::isSeparate(const SplitNet* m, const SplitNet* n) {
         return true;
     }
     if (!(m->_parent)) {
-        printlog(LOG_WARN, "nullptr parent net of %s", m->name().c_str());
+        printlog(LOG_WARN, "nullptr parent net of %s", m->name().data());
         return true;
     }
     if (!(n->_parent)) {
-        printlog(LOG_WARN, "nullptr parent net of %s", n->name().c_str());
+        printlog(LOG_WARN, "nullptr parent net of %s", n->name().data());
         return true;
     }
     return !Rectangle::hasIntersect(*m->_parent, *n->_parent);
@@ -81,12 +81,14 @@ public:
         : _dir(dir), _len(len), _width(width), fromNode(fromi), toNode(toi) {}
 
     char dir() const { return _dir; }
+    unsigned len() const { return _len; }
     int width() const { return _width; }
 };
 
 class NetRouting : public Rectangle {
 protected:
-    string _name = "";
+    //  view into `Database::names`
+    string_view _name = "";
     unsigned _len = 0;
     double _pitchLen = 0;
     unsigned _numVias = 0;
@@ -100,11 +102,11 @@ public:
     vector<Pin*> pins;
     vector<bg::index::rtree<std::pair<boostBox, Pin*>, bg::index::rstar<32>>> rtrees;
 
-    NetRouting(const string& name, const unsigned nLayers)
+    NetRouting(const string_view name, const unsigned nLayers)
         : _name(name), lens(32, 0), pitchLens(32, 0), nVias(32, 0), rtrees(nLayers) {}
-    const string& name() const { return _name; }
+    string_view name() const { return _name; }
+    void name(const string_view n) { _name = n; }
 
-    void eraseBackslashInName() { _name.erase(remove(_name.begin(), _name.end(), '\\'), _name.end()); }
     void addNode(const NetRouteNode& n, const bool updatePin = true);
     void addWire(const NetRouteNode& fromNode, const NetRouteNode& toNode, const int width, const char dir = '\0');
 
@@ -134,7 +136,7 @@ public:
     const NDR* ndr = nullptr;
     vector<Geometry> shapes;
 
-    Net(const string& name, const NDR* ndr, const Use::UseEnum use, const unsigned nLayers)
+    Net(const string_view name, const NDR* ndr, const Use::UseEnum use, const unsigned nLayers)
         : NetRouting(name, nLayers), _use(use), ndr(ndr) {}
     bool globalRouted() const { return gRouted; }
     bool detailedRouted() const { return dRouted; }
@@ -165,16 +167,31 @@ class SplitNet : public Net {
 private:
     bool _isSelected = false;
     double _totalCap = 0;
+    //  extracted from the FEOL routing, in ohm and pF
+    double _wireRes = 0;
+    double _wireCap = 0;
+    double _loadCap = 0;
     const Net* _parent = nullptr;
 
 public:
     vector<NetRouteUpNode> upVias;
+    //  Elmore delay in ps of each up via: from the driver pin of a source,
+    //  or to the farthest sink pin of a sink
+    vector<double> elmores;
 
-    SplitNet(const string& name, const NDR* ndr, const Net* parent)
+    //  `name` is a view into `Database::names`
+    SplitNet(const string_view name, const NDR* ndr, const Net* parent)
         : Net(name, ndr, Use::UseEnum::Signal, 0), _parent(parent) {}
 
+    //  the names of split nets are "<parent>_split_<comp>" for a routed component and "<cell>_<pin>" or "<iopin>"
+    //  for a single pin, without backslashes
+    static string nameOf(const Net* parent, const unsigned comp);
+    static string nameOf(const Pin* pin);
     bool isSelected() const { return _isSelected; }
     double totalCap() const { return _totalCap; }
+    double wireRes() const { return _wireRes; }
+    double wireCap() const { return _wireCap; }
+    double loadCap() const { return _loadCap; }
     const Net* parent() const { return _parent; }
 
     void select() { _isSelected = true; }
@@ -184,8 +201,23 @@ public:
     bool isSource() { return iPin() && _parent; }
 
     void addUpVia(const NetRouteNode& n);
-
-    void write(ostream& os, const string& design, const Rectangle& die, const Point& pitch, const unsigned dir) const;
+    //  wire R/C from the unit R/C of the layers, pin capacitances are in `capacitanceUnit` pF
+    void extractRC(const vector<Layer*>& cLayers, const double dbuMicron, const double capacitanceUnit);
+
+    //  an up via of a split net, a row of the driver and sink tables
+    struct ViaRow {
+        const SplitNet* net;
+        unsigned viaIdx;
+    };
+    //  every column of a split net, also in the driver and sink tables
+    static vector<Column<const SplitNet*>> netColumns();
+    //  every column of the driver and sink tables
+    static vector<Column<ViaRow>> columns(const string& design,
+                                          const Rectangle& die,
+                                          const Point& pitch,
+                                          const unsigned dir,
+                                          const ImageDensity& density);
+    void write(io::RowGroup& rows, const vector<Column<ViaRow>>& columns) const;
 
     static bool isSeparate(const SplitNet* m, const SplitNet* n);
 };
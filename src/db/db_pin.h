@@ -95,6 +95,11 @@ public:
     void arrive(double a) { _arrive = a; }
     void require(double r) { _require = r; }
     void net(Net* n) { _net = n; }
+    //  set the net of a pin that has none, against other threads doing the same; false if it has another one
+    bool claimNet(Net* n) {
+        Net* other = nullptr;
+        return __atomic_compare_exchange_n(&_net, &other, n, false, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE) || other == n;
+    }
     void nrn(const NetRouteNode& nrn) { _nrn = nrn; }
     void splitNet(const SplitNet* s) { _splitNet = s; }
 
@@ -463,7 +463,7 @@ bool Database::readBSAux(const std::string& auxFile, const std::string& plFile)
             if (!cell->fixed() && isWu2016 && cell->height() > 2 * bsData.siteHeight) {
                 printlog(LOG_ERROR,
                          "cell %s [w=%d h=%d] is forced to be fixed at (%d,%d)",
-                         cell->name().c_str(),
+                         cell->name().data(),
                          cell->width(),
                          cell->height(),
                          cell->lx(),
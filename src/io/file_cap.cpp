@@ -1,86 +1,185 @@
+#include <omp.h>
+
+#include <charconv>
+
 #include "../db/db.h"
 #include "../global.h"
+#include "utils.h"
 
 using namespace db;
 
+namespace {
+//  Whitespace separated tokens of the lines of a report, extracted like `istringstream >>` without copying
+class ReportReader {
+private:
+    const char* _pos;
+    const char* const _end;
+    const char* _line = nullptr;
+    const char* _lineBegin = nullptr;
+    const char* _lineEnd = nullptr;
+
+    static bool isSpace(const char c) { return c == ' ' || c == '\t' || c == '\r' || c == '\v' || c == '\f'; }
+
+public:
+    ReportReader(const char* begin, const char* end) : _pos(begin), _end(end) {}
+
+    bool nextLine() {
+        if (_pos == _end) return false;
+        _line = _lineBegin = _pos;
+        _lineEnd = static_cast<const char*>(memchr(_pos, '\n', _end - _pos));
+        if (!_lineEnd) _lineEnd = _end;
+        _pos = _lineEnd == _end ? _end : _lineEnd + 1;
+        return true;
+    }
+    string_view line() const { return string_view(_line, _lineEnd - _line); }
+
+    //  empty at the end of the line
+    string_view next() {
+        while (_lineBegin != _lineEnd && isSpace(*_lineBegin)) ++_lineBegin;
+        const char* begin = _lineBegin;
+        while (_lineBegin != _lineEnd && !isSpace(*_lineBegin)) ++_lineBegin;
+        return string_view(begin, _lineBegin - begin);
+    }
+    void skip(const unsigned n) {
+        for (unsigned i = 0; i != n; ++i) next();
+    }
+    double number() {
+        string_view token = next();
+        if (token.size() && token.front() == '+') token.remove_prefix(1);
+        double value = 0;
+        from_chars(token.data(), token.data() + token.size(), value);
+        return value;
+    }
+};
+
+//  the lines of a report that are read in parallel
+vector<const char*> splitReport(const io::MappedFile& mapped) {
+    const unsigned nChunks = mapped.size() < (1 << 20) ? 1 : omp_get_max_threads() * 4;
+    return io::splitLines(mapped.begin(), mapped.end(), nChunks);
+}
+
+//  0 is an unknown required time
+double minRequire(const double a, const double b) {
+    if (!a) return b;
+    if (!b) return a;
+    return min(a, b);
+}
+
+struct PinTiming {
+    double delay = 0;
+    double arrive = 0;
+    double require = 0;
+};
+}  // namespace
+
 bool Database::readNetDetail(const std::string& file)
 {
-    ifstream fs(file.c_str());
-    if (!fs.good()) {
+    io::MappedFile mapped;
+    if (!mapped.open(file)) {
         printlog(LOG_ERROR, "cannot open net detail file: %s", file.c_str());
         return false;
     }
 
     printlog(LOG_INFO, "reading %s", file.c_str());
-    string line = "";
-    while (getline(fs, line)) {
-        istringstream iss(line);
-        string buffer = "";
-        string name = "";
-        iss >> buffer;
-        if (buffer != "|") continue;
-        iss >> name >> buffer >> buffer;
-        if (name.empty() || name == "|" || buffer == "|") continue;
-        SplitNet* net = getSplitNet(name);
-        if (!net) {
-            printlog(LOG_ERROR, "split net %s not found in line %s", name.c_str(), line.c_str());
-            break;
-        }
-        for (unsigned i = 0; i != 6;) {
-            iss >> buffer;
-            if (buffer == "|") ++i;
+    //  the lookups below run concurrently
+    indexSplitNets();
+
+    const vector<const char*> bounds = splitReport(mapped);
+    const unsigned nChunks = bounds.size() - 1;
+    vector<vector<pair<SplitNet*, double>>> chunkCaps(nChunks);
+    vector<string> chunkErrors(nChunks);
+#pragma omp parallel for schedule(dynamic)
+    for (unsigned i = 0; i < nChunks; ++i) {
+        ReportReader reader(bounds[i], bounds[i + 1]);
+        while (reader.nextLine()) {
+            if (reader.next() != "|") continue;
+            const string_view name = reader.next();
+            reader.next();
+            const string_view buffer = reader.next();
+            if (name.empty() || name == "|" || buffer == "|") continue;
+            SplitNet* net = getSplitNet(name);
+            if (!net) {
+                chunkErrors[i].append(name).append(" not found in line ").append(reader.line());
+                break;
+            }
+            for (unsigned nBars = 0; nBars != 6;) {
+                const string_view token = reader.next();
+                if (token.empty()) break;
+                if (token == "|") ++nBars;
+            }
+            chunkCaps[i].emplace_back(net, reader.number());
         }
-        double cap = 0;
-        iss >> cap;
-        net->totalCap(cap);
     }
 
-    fs.close();
+    //  in file order, so the last row of a split net wins and reading stops at the first unknown one
+    for (unsigned i = 0; i != nChunks; ++i) {
+        for (const auto& [net, cap] : chunkCaps[i]) net->totalCap(cap);
+        if (chunkErrors[i].size()) {
+            printlog(LOG_ERROR, "split net %s", chunkErrors[i].c_str());
+            break;
+        }
+    }
     return true;
 }
 
 bool Database::readTimePath(const std::string& file, bool isConstrained) {
-    ifstream fs(file.c_str());
-    if (!fs.good()) {
+    io::MappedFile mapped;
+    if (!mapped.open(file)) {
         printlog(LOG_ERROR, "cannot open time path file: %s", file.c_str());
         return false;
     }
 
     printlog(LOG_INFO, "reading %s", file.c_str());
-    string line = "";
-    while (getline(fs, line)) {
-        istringstream iss(line);
-        string buffer = "";
-        string cellName = "";
-        string pinName = "";
-        iss >> buffer;
-        if (buffer != "|") continue;
-        iss >> cellName >> buffer >> buffer >> buffer;
-        if (cellName.empty() || cellName == "|" || buffer == "|") continue;
-        Cell* cell = getCell(cellName);
-        if (!cell) {
-            printlog(LOG_ERROR, "cannot find cell: %s", cellName.c_str());
-            return false;
+    const vector<const char*> bounds = splitReport(mapped);
+    const unsigned nChunks = bounds.size() - 1;
+    //  per chunk reductions, merged in file order
+    vector<unordered_map<Pin*, PinTiming>> chunkTimings(nChunks);
+    vector<string> chunkErrors(nChunks);
+#pragma omp parallel for schedule(dynamic)
+    for (unsigned i = 0; i < nChunks; ++i) {
+        ReportReader reader(bounds[i], bounds[i + 1]);
+        while (reader.nextLine()) {
+            if (reader.next() != "|") continue;
+            const string_view cellName = reader.next();
+            reader.skip(2);
+            const string_view buffer = reader.next();
+            if (cellName.empty() || cellName == "|" || buffer == "|") continue;
+            Cell* cell = getCell(cellName);
+            if (!cell) {
+                chunkErrors[i].append("cannot find cell: ").append(cellName);
+                break;
+            }
+            reader.next();
+            const string_view pinName = reader.next();
+            reader.skip(4);
+            const double delay = reader.number();
+            reader.next();
+            const double arrive = reader.number();
+            reader.next();
+            if (pinName.empty() || pinName == "|") continue;
+            Pin* pin = cell->pin(pinName);
+            if (!pin) {
+                chunkErrors[i].append("cannot find pin ").append(pinName).append(" in cell: ").append(cellName);
+                break;
+            }
+            if (!pin->splitNet()) continue;
+            PinTiming& timing = chunkTimings[i][pin];
+            timing.delay = max(timing.delay, delay);
+            timing.arrive = max(timing.arrive, arrive);
+            if (isConstrained) timing.require = minRequire(timing.require, reader.number());
         }
-        double delay = 0;
-        double arrive = 0;
-        iss >> buffer >> pinName >> buffer >> buffer >> buffer >> buffer >> delay >> buffer >> arrive >> buffer;
-        if (pinName.empty() || pinName == "|") continue;
-        Pin* pin = cell->pin(pinName);
-        if (!pin) {
-            printlog(LOG_ERROR, "cannot find pin %s in cell: %s", pinName.c_str(), cellName.c_str());
+    }
+
+    for (unsigned i = 0; i != nChunks; ++i) {
+        for (const auto& [pin, timing] : chunkTimings[i]) {
+            pin->delay(max(pin->delay(), timing.delay));
+            pin->arrive(max(pin->arrive(), timing.arrive));
+            if (isConstrained) pin->require(minRequire(pin->require(), timing.require));
+        }
+        if (chunkErrors[i].size()) {
+            printlog(LOG_ERROR, "%s", chunkErrors[i].c_str());
             return false;
         }
-        if (!pin->splitNet()) continue;
-        pin->delay(max(pin->delay(), delay));
-        pin->arrive(max(pin->arrive(), arrive));
-        if (!isConstrained) continue;
-        double require = 0;
-        iss >> require;
-        if (pin->require()) pin->require(min(pin->require(), require));
-        else pin->require(require);
     }
-
     return true;
 }
-
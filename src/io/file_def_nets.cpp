@@ -0,0 +1,373 @@
+#include "file_def_nets.h"
+
+#include <omp.h>
+
+#include <charconv>
+#include <unordered_set>
+
+#include "../global.h"
+#include "../ut/utils.h"
+using namespace db;
+
+/***** DefNetWire *****/
+
+void io::DefNetWire::layer(Layer* layer) {
+    _layer = layer;
+    _width = layer->width;
+    _layerBelow = _db.getRLayer(layer->rIdx - 1);
+    _layerAbove = _db.getRLayer(layer->rIdx + 1);
+    _fromx = 0;
+    _fromy = 0;
+    _fromz = -1;
+    _nNodes = 0;
+}
+
+void io::DefNetWire::via(const ViaType* viaType) {
+    for (const Geometry& geo : viaType->rects) {
+        if (geo.layer->rIdx < 0) continue;
+        // via has two routing layers; one at the current layer, second is above or below
+        if (geo.layer->rIdx > _layer->rIdx) {  // second via layer is above
+            _net->addNode({_layer, _fromx, _fromy, -1}, _updatePin);
+            _net->addNode({_layerAbove, _fromx, _fromy, -1}, _updatePin);
+            _net->addWire({_layer, _fromx, _fromy, -1}, {_layerAbove, _fromx, _fromy, -1}, -1);
+        } else if (geo.layer->rIdx < _layer->rIdx) {  // second via layer is below
+            _net->addNode({_layer, _fromx, _fromy, -1}, _updatePin);
+            _net->addNode({_layerBelow, _fromx, _fromy, -1}, _updatePin);
+            _net->addWire({_layer, _fromx, _fromy, -1}, {_layerBelow, _fromx, _fromy, -1}, -1);
+        }
+    }
+}
+
+void io::DefNetWire::flushPoint(const int x, const int y, const int z) {
+    if (_nNodes++) {
+        _net->addNode({_layer, _fromx, _fromy, _fromz}, _updatePin);
+        _net->addNode({_layer, x, y, z}, _updatePin);
+        _net->addWire({_layer, _fromx, _fromy, _fromz}, {_layer, x, y, z}, _width);
+    }
+    _fromx = x;
+    _fromy = y;
+    _fromz = z;
+}
+
+void io::DefNetWire::rect(const int lx, const int ly, const int hx, const int hy) {
+    _net->shapes.emplace_back(_layer, _fromx + lx, _fromy + ly, _fromx + hx, _fromy + hy);
+}
+
+/***** NETS section *****/
+
+namespace {
+inline bool isBlank(const char c) { return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\f' || c == '\v'; }
+
+//  whether the line at `p` starts with the keywords in `words`, ignoring indentation
+bool lineStartsWith(const char* p, const char* end, std::initializer_list<string_view> words) {
+    for (const string_view word : words) {
+        while (p != end && (*p == ' ' || *p == '\t')) ++p;
+        if (static_cast<size_t>(end - p) <= word.size() || string_view(p, word.size()) != word) return false;
+        p += word.size();
+        if (!isBlank(*p) && *p != ';') return false;
+    }
+    return true;
+}
+
+const char* nextLine(const char* p, const char* end) {
+    p = static_cast<const char*>(memchr(p, '\n', end - p));
+    return p ? p + 1 : end;
+}
+
+//  Tokenizer and parser for the statements of a NETS section.
+//  Only the constructs produced by routers are accepted; anything else makes `parse` fail
+//  and the caller falls back to the def58 reader.
+class DefNetsParser {
+private:
+    Database& _db;
+    const char* _p;
+    const char* const _end;
+
+    bool next(string_view& token);
+    bool peek(string_view& token) {
+        const char* p = _p;
+        const bool ret = next(token);
+        _p = p;
+        return ret;
+    }
+    bool expect(const string_view keyword) {
+        string_view token;
+        return next(token) && token == keyword;
+    }
+    bool nextInt(int& value) {
+        string_view token;
+        if (!next(token)) return false;
+        const std::from_chars_result res = std::from_chars(token.data(), token.data() + token.size(), value);
+        return res.ec == std::errc() && res.ptr == token.data() + token.size();
+    }
+    //  an integer or '*' to repeat the previous value
+    bool nextCoord(int& value) {
+        string_view token;
+        if (!peek(token)) return false;
+        if (token == "*") return next(token);
+        return nextInt(value);
+    }
+    bool parseConnection(Net* net);
+    bool parseWiring(io::DefNetWire& wire);
+
+public:
+    DefNetsParser(Database& db, const char* begin, const char* end) : _db(db), _p(begin), _end(end) {}
+
+    //  created nets are appended to `nets` together with their raw names, even on failure
+    bool parse(vector<pair<string_view, Net*>>& nets);
+};
+
+bool DefNetsParser::next(string_view& token) {
+    while (true) {
+        while (_p != _end && isBlank(*_p)) ++_p;
+        if (_p == _end) return false;
+        if (*_p != '#') break;
+        _p = nextLine(_p, _end);
+    }
+    const char* begin = _p;
+    while (_p != _end && !isBlank(*_p)) ++_p;
+    token = string_view(begin, _p - begin);
+    return true;
+}
+
+bool DefNetsParser::parseConnection(Net* net) {
+    string_view instance;
+    string_view pinName;
+    string_view token;
+    if (!next(instance) || !next(pinName) || !next(token)) return false;
+    if (instance == "*" || instance.front() == '"' || pinName.front() == '"') return false;
+    if (token == "+") {
+        if (!expect("SYNTHESIZED") || !next(token)) return false;
+    }
+    if (token != ")") return false;
+
+    Pin* pin = _db.getPinFromConnection(string(instance), string(pinName));
+    if (!pin) return true;
+    //  chunks run in parallel, a pin of two nets is left to the DEF parser
+    if (!pin->claimNet(net)) {
+        printlog(LOG_WARN, "Pin %s %s is in more than one net", string(instance).c_str(), string(pinName).c_str());
+        return false;
+    }
+    net->addPin(pin);
+    return true;
+}
+
+bool DefNetsParser::parseWiring(io::DefNetWire& wire) {
+    string_view token;
+    if (!next(token)) return false;
+    while (true) {
+        Layer* layer = _db.getLayer(token);
+        if (!layer) return false;
+        wire.layer(layer);
+        int x = 0;
+        int y = 0;
+        while (true) {
+            if (!peek(token)) return false;
+            if (token == "+" || token == ";") return true;
+            next(token);
+            if (token == "NEW") break;
+            if (token == "(") {
+                if (!nextCoord(x) || !nextCoord(y) || !next(token)) return false;
+                if (token == ")") {
+                    wire.point(x, y);
+                    continue;
+                }
+                int z = 0;
+                const std::from_chars_result res = std::from_chars(token.data(), token.data() + token.size(), z);
+                if (res.ec != std::errc() || res.ptr != token.data() + token.size() || !expect(")")) return false;
+                wire.flushPoint(x, y, z);
+            } else if (token == "RECT") {
+                int lx = 0;
+                int ly = 0;
+                int hx = 0;
+                int hy = 0;
+                if (!expect("(") || !nextInt(lx) || !nextInt(ly) || !nextInt(hx) || !nextInt(hy) || !expect(")")) {
+                    return false;
+                }
+                wire.rect(lx, ly, hx, hy);
+            } else if (token == "VIRTUAL") {
+                int vx = 0;
+                int vy = 0;
+                if (!expect("(") || !nextCoord(vx) || !nextCoord(vy) || !expect(")")) return false;
+            } else if (token == "TAPERRULE" || token == "STYLE" || token == "MASK") {
+                if (!next(token)) return false;
+            } else if (token == "TAPER") {
+            } else if (token == "N" || token == "S" || token == "E" || token == "W" || token == "FN" || token == "FS" ||
+                       token == "FE" || token == "FW") {
+                //  via rotation
+            } else {
+                const ViaType* viaType = _db.getViaType(string(token));
+                if (!viaType) return false;
+                wire.via(viaType);
+            }
+        }
+        if (!next(token)) return false;
+    }
+}
+
+bool DefNetsParser::parse(vector<pair<string_view, Net*>>& nets) {
+    string_view token;
+    while (next(token)) {
+        string_view name;
+        if (token != "-" || !next(name) || name == "MUSTJOIN" || name.front() == '"') return false;
+        Net* net = new Net("", nullptr, Use::UseEnum::Signal, _db.nLayers);
+        nets.emplace_back(name, net);
+        io::DefNetWire wire(_db, net, true);
+        while (true) {
+            if (!next(token)) return false;
+            if (token == ";") break;
+            if (token == "(") {
+                if (!parseConnection(net)) return false;
+                continue;
+            }
+            if (token != "+" || !next(token)) return false;
+            if (token == "ROUTED" || token == "FIXED" || token == "COVER" || token == "NOSHIELD") {
+                if (!parseWiring(wire)) return false;
+            } else if (token == "NONDEFAULTRULE") {
+                if (!next(token)) return false;
+                const string ndrName(token);
+                net->ndr = _db.getNDR(ndrName);
+                if (!net->ndr) printlog(LOG_WARN, "NDR rule is not found: %s", ndrName.c_str());
+            } else if (token == "SOURCE" || token == "USE" || token == "WEIGHT" || token == "SHIELDNET" ||
+                       token == "ORIGINAL" || token == "PATTERN" || token == "ESTCAP" || token == "FREQUENCY" ||
+                       token == "XTALK") {
+                if (!next(token)) return false;
+            } else if (token != "FIXEDBUMP") {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+//  split [begin, end) into about `n` chunks that each start at a net statement
+vector<const char*> splitDefNets(const char* begin, const char* end, const unsigned n) {
+    vector<const char*> bounds{begin};
+    for (unsigned i = 1; i < n; ++i) {
+        const char* p = std::max(begin + (end - begin) / n * i, bounds.back());
+        while ((p = static_cast<const char*>(memchr(p, ';', end - p)))) {
+            ++p;
+            while (p != end && isBlank(*p)) ++p;
+            if (end - p > 1 && *p == '-' && isBlank(p[1])) break;
+        }
+        if (!p) break;
+        if (p != bounds.back()) bounds.push_back(p);
+    }
+    bounds.push_back(end);
+    return bounds;
+}
+
+struct HoleCookie {
+    const char* begin;
+    const char* end;
+    const char* holeBegin;
+    const char* holeEnd;
+    const char* pos;
+};
+
+ssize_t readHole(void* cookie, char* buf, size_t size) {
+    HoleCookie& hole = *static_cast<HoleCookie*>(cookie);
+    size_t nRead = 0;
+    while (nRead < size && hole.pos != hole.end) {
+        if (hole.pos == hole.holeBegin) hole.pos = hole.holeEnd;
+        const char* stop = hole.pos < hole.holeBegin ? hole.holeBegin : hole.end;
+        const size_t len = std::min(size - nRead, static_cast<size_t>(stop - hole.pos));
+        memcpy(buf + nRead, hole.pos, len);
+        nRead += len;
+        hole.pos += len;
+    }
+    return nRead;
+}
+
+int closeHole(void* cookie) {
+    delete static_cast<HoleCookie*>(cookie);
+    return 0;
+}
+}  // namespace
+
+bool io::findDefNets(const char* begin,
+                     const char* end,
+                     const char*& sectionBegin,
+                     const char*& bodyBegin,
+                     const char*& bodyEnd,
+                     const char*& sectionEnd) {
+    const char* p = begin;
+    while (p != end && !lineStartsWith(p, end, {"NETS"})) p = nextLine(p, end);
+    if (p == end) return false;
+    sectionBegin = p;
+    bodyBegin = static_cast<const char*>(memchr(p, ';', end - p));
+    if (!bodyBegin) return false;
+    ++bodyBegin;
+    for (p = nextLine(bodyBegin, end); p != end && !lineStartsWith(p, end, {"END", "NETS"}); p = nextLine(p, end)) {
+    }
+    if (p == end) return false;
+    bodyEnd = p;
+    sectionEnd = nextLine(p, end);
+    return true;
+}
+
+FILE* io::openWithHole(const char* begin, const char* end, const char* holeBegin, const char* holeEnd) {
+    HoleCookie* cookie = new HoleCookie{begin, end, holeBegin, holeEnd, begin};
+    FILE* fp = fopencookie(cookie, "r", {readHole, nullptr, nullptr, closeHole});
+    if (!fp) delete cookie;
+    return fp;
+}
+
+/***** Database *****/
+
+bool Database::readDefNets(const char* begin, const char* end) {
+    const vector<const char*> bounds = splitDefNets(begin, end, omp_get_max_threads() * 4);
+    const unsigned nChunks = bounds.size() - 1;
+    vector<vector<pair<string_view, Net*>>> chunkNets(nChunks);
+    vector<char> chunkOk(nChunks, 0);
+#pragma omp parallel for schedule(dynamic)
+    for (unsigned i = 0; i < nChunks; ++i) {
+        chunkOk[i] = DefNetsParser(*this, bounds[i], bounds[i + 1]).parse(chunkNets[i]);
+    }
+
+    //  the nets are merged by the DEF parser when a name repeats
+    bool ok = std::find(chunkOk.begin(), chunkOk.end(), 0) == chunkOk.end();
+    unordered_set<string> netNames;
+    for (unsigned i = 0; i != nChunks && ok; ++i) {
+        for (const auto& [rawName, net] : chunkNets[i]) {
+            string n(rawName);
+            replace(n.begin(), n.end(), '/', '_');
+            if (getNet(n) || !netNames.insert(n).second) {
+                printlog(LOG_WARN, "Net re-defined: %s", n.c_str());
+                ok = false;
+                break;
+            }
+        }
+    }
+    if (!ok) {
+        for (const vector<pair<string_view, Net*>>& nets : chunkNets) {
+            for (const auto& [name, net] : nets) {
+                for (Pin* pin : net->pins) {
+                    pin->net(nullptr);
+                    pin->nrn(NetRouteNode());
+                }
+                delete net;
+            }
+        }
+        return false;
+    }
+
+    size_t nNets = 0;
+    for (const vector<pair<string_view, Net*>>& nets : chunkNets) nNets += nets.size();
+    this->nets.reserve(this->nets.size() + nNets);
+    for (const vector<pair<string_view, Net*>>& nets : chunkNets) {
+        for (const auto& [rawName, net] : nets) {
+            string n(rawName);
+            replace(n.begin(), n.end(), '/', '_');
+            const unsigned id = names.intern(n);
+            net->name(names.name(id));
+#ifdef _GNUC_4_8_
+            name_nets.emplace(id, net);
+#else
+            name_nets[id] = net;
+#endif
+            this->nets.push_back(net);
+        }
+    }
+    return true;
+}
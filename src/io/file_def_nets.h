@@ -0,0 +1,52 @@
+#ifndef _IO_FILE_DEF_NETS_H_
+#define _IO_FILE_DEF_NETS_H_
+
+#include "../db/db.h"
+
+namespace io {
+//  Turns the path events of a DEF net into routing nodes and wires.
+//  Shared by the def58 callbacks and the memory-mapped NETS reader so that both build identical routes.
+class DefNetWire {
+private:
+    db::Database& _db;
+    db::Net* _net;
+    const bool _updatePin;
+
+    db::Layer* _layer = nullptr;
+    const db::Layer* _layerAbove = nullptr;
+    const db::Layer* _layerBelow = nullptr;
+    int _width = -1;
+    int _fromx = 0;
+    int _fromy = 0;
+    int _fromz = -1;
+    unsigned _nNodes = 0;
+
+public:
+    DefNetWire(db::Database& db, db::Net* net, const bool updatePin) : _db(db), _net(net), _updatePin(updatePin) {}
+
+    bool hasLayer() const { return _layer; }
+
+    void layer(db::Layer* layer);
+    void via(const db::ViaType* viaType);
+    void width(const int width) { _width = width; }
+    void point(const int x, const int y) { flushPoint(x, y, -1); }
+    void flushPoint(const int x, const int y, const int z);
+    void rect(const int lx, const int ly, const int hx, const int hy);
+};
+
+//  Locate the NETS section of a DEF image.
+//  [sectionBegin, sectionEnd) covers the whole section including "NETS n ;" and "END NETS",
+//  [bodyBegin, bodyEnd) covers the net statements only.
+bool findDefNets(const char* begin,
+                 const char* end,
+                 const char*& sectionBegin,
+                 const char*& bodyBegin,
+                 const char*& bodyEnd,
+                 const char*& sectionEnd);
+
+//  Open a stdio stream over [begin, end) that skips [holeBegin, holeEnd).
+//  The memory must outlive the stream.
+FILE* openWithHole(const char* begin, const char* end, const char* holeBegin, const char* holeEnd);
+}  // namespace io
+
+#endif
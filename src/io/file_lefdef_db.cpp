@@ -7,7 +7,9 @@
 #include "../def58/inc/defiUtil.hpp"
 #include "../def58/inc/defrReader.hpp"
 #include "../global.h"
+#include "../io/file_def_nets.h"
 #include "../io/io.h"
+#include "../io/utils.h"
 #include "../lef58/inc/lefrReader.hpp"
 #include "../sta/sta.h"
 #include "../ut/utils.h"
@@ -197,8 +199,8 @@ int readDefSNet(defrCallbackType_e c, defiNet* dnet, defiUserData ud);
 Database& getDBFromUD(defiUserData ud) { return *static_cast<Database*>(ud); }
 
 bool Database::readLEF(const string& file) {
-    FILE* fp;
-    if (!(fp = fopen(file.c_str(), "r"))) {
+    io::InputFile lef;
+    if (!lef.open(file)) {
         printlog(LOG_ERROR, "Unable to open LEF file: %s", file.c_str());
         return false;
     }
@@ -217,7 +219,7 @@ bool Database::readLEF(const string& file) {
     lefrSetPinCbk(readLefPin);
     lefrInit();
     lefrReset();
-    int res = lefrRead(fp, file.c_str(), (void*)&database);
+    int res = lefrRead(lef.fp(), file.c_str(), (void*)&database);
     if (res) {
         printlog(LOG_ERROR, "Error in reading LEF");
         return false;
@@ -227,41 +229,34 @@ bool Database::readLEF(const string& file) {
     lefrUnsetLayerCbk();
     lefrUnsetNonDefaultCbk();
     lefrUnsetViaCbk();
-    fclose(fp);
-    return true;
+    return lef.close();
 }
 
-bool Database::readDEF(const string& file) {
-    FILE* fp;
-    if (!(fp = fopen(file.c_str(), "r"))) {
-        printlog(LOG_ERROR, "Unable to open DEF file: %s", file.c_str());
-        return false;
+//  read `fp` with the NETS callback and/or all the other callbacks
+bool readDefCallbacks(FILE* fp, const string& file, const bool readNets, const bool readOthers) {
+    if (readOthers) {
+        defrSetDesignCbk(readDefDesign);
+        defrSetUnitsCbk(readDefUnits);
+        defrSetDieAreaCbk(readDefDieArea);
+        defrSetRowCbk(readDefRow);
+        defrSetTrackCbk(readDefTrack);
+        defrSetViaCbk(readDefVia);
+        defrSetNonDefaultCbk(readDefNdr);
+        defrSetComponentCbk(readDefComponent);
+        defrSetPinCbk(readDefPin);
+
+        defrSetRegionCbk(readDefRegion);
+        defrSetGroupMemberCbk(readDefGroupMember);
+        defrSetGroupCbk(readDefGroup);
+
+        defrSetSNetStartCbk(readDefSNetStart);
+        defrSetSNetCbk(readDefSNet);
+    }
+    if (readNets) {
+        defrSetNetCbk(readDefNet);
+        // augment nets with path data
+        defrSetAddPathToNet();
     }
-
-#ifndef NDEBUG
-    printlog(LOG_INFO, "reading %s", file.c_str());
-#endif
-
-    defrSetDesignCbk(readDefDesign);
-    defrSetUnitsCbk(readDefUnits);
-    defrSetDieAreaCbk(readDefDieArea);
-    defrSetRowCbk(readDefRow);
-    defrSetTrackCbk(readDefTrack);
-    defrSetViaCbk(readDefVia);
-    defrSetNonDefaultCbk(readDefNdr);
-    defrSetComponentCbk(readDefComponent);
-    defrSetPinCbk(readDefPin);
-
-    defrSetNetCbk(readDefNet);
-    // augment nets with path data
-    defrSetAddPathToNet();
-
-    defrSetRegionCbk(readDefRegion);
-    defrSetGroupMemberCbk(readDefGroupMember);
-    defrSetGroupCbk(readDefGroup);
-
-    defrSetSNetStartCbk(readDefSNetStart);
-    defrSetSNetCbk(readDefSNet);
 
     defrInit();
     defrReset();
@@ -272,10 +267,51 @@ bool Database::readDEF(const string& file) {
     }
     defrReleaseNResetMemory();
     defrUnsetCallbacks();
-    fclose(fp);
     return true;
 }
 
+bool Database::readDEF(const string& file) {
+#ifndef NDEBUG
+    printlog(LOG_INFO, "reading %s", file.c_str());
+#endif
+
+    //  the NETS section is parsed in parallel from a memory mapping, the rest by def58
+    io::MappedFile def;
+    const char* sectionBegin = nullptr;
+    const char* bodyBegin = nullptr;
+    const char* bodyEnd = nullptr;
+    const char* sectionEnd = nullptr;
+    if (!io::InputFile::isCompressed(file) && def.open(file) &&
+        io::findDefNets(def.begin(), def.end(), sectionBegin, bodyBegin, bodyEnd, sectionEnd)) {
+        FILE* fp = io::openWithHole(def.begin(), def.end(), sectionBegin, sectionEnd);
+        if (fp) {
+            const bool ok = readDefCallbacks(fp, file, false, true);
+            fclose(fp);
+            if (!ok) return false;
+            if (readDefNets(bodyBegin, bodyEnd)) return true;
+
+            printlog(LOG_WARN, "Cannot read NETS in parallel, re-reading them with the DEF parser");
+            io::InputFile nets;
+            if (!nets.open(file)) {
+                printlog(LOG_ERROR, "Unable to open DEF file: %s", file.c_str());
+                return false;
+            }
+            const bool netsOk = readDefCallbacks(nets.fp(), file, true, false);
+            return nets.close() && netsOk;
+        }
+    }
+    def.close();
+
+    //  compressed files are streamed through def58 as they are inflated
+    io::InputFile input;
+    if (!input.open(file)) {
+        printlog(LOG_ERROR, "Unable to open DEF file: %s", file.c_str());
+        return false;
+    }
+    const bool ok = readDefCallbacks(input.fp(), file, true, true);
+    return input.close() && ok;
+}
+
 /****************/
 /* LEF Callback */
 /****************/
@@ -402,6 +438,10 @@ int readLefLayer(lefrCallbackType_e c, lefiLayer* leflayer, lefiUserData ud) {
             } else {
                 // no pitch nor width information
             }
+
+            if (leflayer->hasResistance()) layer->resistance = leflayer->resistance();
+            if (leflayer->hasCapacitance()) layer->capacitance = leflayer->capacitance();
+            if (leflayer->hasEdgeCap()) layer->edgeCapacitance = leflayer->edgeCap();
             return 0;
         case 'c':
             // cut (via) layer
@@ -412,6 +452,11 @@ int readLefLayer(lefrCallbackType_e c, lefiLayer* leflayer, lefiUserData ud) {
                     layer->spacing = leflayer->spacing(i);
                 }
             }
+            if (leflayer->hasResistancePerCut()) {
+                layer->resistance = leflayer->resistancePerCut();
+            } else if (leflayer->hasResistance()) {
+                layer->resistance = leflayer->resistance();
+            }
             return 0;
         default:
             return 0;
@@ -878,20 +923,8 @@ int readDefPin(defrCallbackType_e c, defiPin* dpin, defiUserData ud) {
 
 int readDefNetWire(defiNet* dnet, defiUserData ud, Net* net, const bool updatePin) {
     Database& db = getDBFromUD(ud);
+    io::DefNetWire wire(db, net, updatePin);
     int path = DEFIPATH_DONE;
-    // const Layer* layer = nullptr;
-    Layer* layer = nullptr;
-    const Layer* layerAbove = nullptr;
-    const Layer* layerBelow = nullptr;
-    const ViaType* viaType = nullptr;
-    int width = -1;
-    int fromx = 0;
-    int fromy = 0;
-    int fromz = -1;
-    int tox = 0;
-    int toy = 0;
-    int toz = -1;
-    unsigned nNodes = 0;
     for (unsigned i = 0; static_cast<int>(i) < dnet->numWires(); ++i) {
         const defiWire* dwire = dnet->wire(i);
         for (unsigned j = 0; static_cast<int>(j) < dwire->numPaths(); ++j) {
@@ -900,74 +933,31 @@ int readDefNetWire(defiNet* dnet, defiUserData ud, Net* net, const bool updatePi
             while ((path = dpath->next()) != DEFIPATH_DONE) {
                 switch (path) {
                     case DEFIPATH_LAYER:
-                        fromx = 0;
-                        fromy = 0;
-                        fromz = -1;
-                        tox = 0;
-                        toy = 0;
-                        toz = -1;
-                        nNodes = 0;
-                        layer = db.getLayer(dpath->getLayer());
-                        width = layer->width;
-                        for (const Layer* cLayer : db.layers) {
-                            if (cLayer->rIdx == layer->rIdx - 1) {
-                                layerBelow = cLayer;
-                            } else if (cLayer->rIdx == layer->rIdx + 1) {
-                                layerAbove = cLayer;
-                            }
-                        }
+                        wire.layer(db.getLayer(dpath->getLayer()));
                         break;
                     case DEFIPATH_VIA:
-                        viaType = db.getViaType(dpath->getVia());
-                        for (const Geometry& geo : viaType->rects) {
-                            if (geo.layer->rIdx >= 0) {
-                                // via has two routing layers; one at dpath->layer(), second is above or below
-                                if (geo.layer->rIdx > layer->rIdx) {  // second via layer is above
-                                    net->addNode({layer, fromx, fromy, -1}, updatePin);
-                                    net->addNode({layerAbove, fromx, fromy, -1}, updatePin);
-                                    net->addWire({layer, fromx, fromy, -1}, {layerAbove, fromx, fromy, -1}, -1);
-                                } else if (geo.layer->rIdx < layer->rIdx) {  // second via layer is below
-                                    net->addNode({layer, fromx, fromy, -1}, updatePin);
-                                    net->addNode({layerBelow, fromx, fromy, -1}, updatePin);
-                                    net->addWire({layer, fromx, fromy, -1}, {layerBelow, fromx, fromy, -1}, -1);
-                                }
-                            }
-                        }
+                        wire.via(db.getViaType(dpath->getVia()));
                         break;
                     case DEFIPATH_VIAROTATION:
                         break;
                     case DEFIPATH_WIDTH:
-                        width = dpath->getWidth();
+                        wire.width(dpath->getWidth());
                         break;
-                    case DEFIPATH_POINT:
-                        if (nNodes) {
-                            dpath->getPoint(&tox, &toy);
-                            net->addNode({layer, fromx, fromy, fromz}, updatePin);
-                            net->addNode({layer, tox, toy, -1}, updatePin);
-                            net->addWire({layer, fromx, fromy, fromz}, {layer, tox, toy, -1}, width);
-                            fromx = tox;
-                            fromy = toy;
-                            fromz = -1;
-                        } else {
-                            dpath->getPoint(&fromx, &fromy);
-                            fromz = -1;
-                        }
-                        ++nNodes;
+                    case DEFIPATH_POINT: {
+                        int x = 0;
+                        int y = 0;
+                        dpath->getPoint(&x, &y);
+                        wire.point(x, y);
                         break;
-                    case DEFIPATH_FLUSHPOINT:
-                        if (nNodes) {
-                            dpath->getFlushPoint(&tox, &toy, &toz);
-                            net->addNode({layer, fromx, fromy, fromz}, updatePin);
-                            net->addNode({layer, tox, toy, toz}, updatePin);
-                            net->addWire({layer, fromx, fromy, fromz}, {layer, tox, toy, toz}, width);
-                            fromx = tox;
-                            fromy = toy;
-                            fromz = toz;
-                        } else {
-                            dpath->getFlushPoint(&fromx, &fromy, &fromz);
-                        }
-                        ++nNodes;
+                    }
+                    case DEFIPATH_FLUSHPOINT: {
+                        int x = 0;
+                        int y = 0;
+                        int z = -1;
+                        dpath->getFlushPoint(&x, &y, &z);
+                        wire.flushPoint(x, y, z);
                         break;
+                    }
                     case DEFIPATH_TAPER:
                         break;
                     case DEFIPATH_RECT: {
@@ -976,7 +966,7 @@ int readDefNetWire(defiNet* dnet, defiUserData ud, Net* net, const bool updatePi
                         int hx = 0;
                         int hy = 0;
                         dpath->getViaRect(&lx, &ly, &hx, &hy);
-                        net->shapes.emplace_back(layer, fromx + lx, fromy + ly, fromx + hx, fromy + hy);
+                        wire.rect(lx, ly, hx, hy);
                         break;
                     }
                     case DEFIPATH_TAPERRULE:
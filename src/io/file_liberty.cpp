@@ -0,0 +1,234 @@
+#include "file_liberty.h"
+
+#include <charconv>
+
+#include "file_liberty.tab.h"
+using namespace io;
+
+/***** LibertyKeywords *****/
+
+LibertyKeywords::LibertyKeywords() {
+    static const pair<string_view, LibertyKey> keywords[] = {
+        {"capacitive_load_unit", LibertyKey::CapacitiveLoadUnit},
+        {"capacitance", LibertyKey::Capacitance},
+        {"cell", LibertyKey::Cell},
+        {"cell_fall", LibertyKey::CellFall},
+        {"cell_rise", LibertyKey::CellRise},
+        {"direction", LibertyKey::Direction},
+        {"drive_strength", LibertyKey::DriveStrength},
+        {"fall_constraint", LibertyKey::FallConstraint},
+        {"fall_power", LibertyKey::FallPower},
+        {"fall_transition", LibertyKey::FallTransition},
+        {"index_1", LibertyKey::Index1},
+        {"index_2", LibertyKey::Index2},
+        {"index_3", LibertyKey::Index3},
+        {"library", LibertyKey::Library},
+        {"lu_table_template", LibertyKey::LuTableTemplate},
+        {"max_capacitance", LibertyKey::MaxCapacitance},
+        {"min_capacitance", LibertyKey::MinCapacitance},
+        {"pin", LibertyKey::Pin},
+        {"power_lut_template", LibertyKey::PowerLutTemplate},
+        {"receiver_capacitance1_fall", LibertyKey::ReceiverCapacitance1Fall},
+        {"receiver_capacitance1_rise", LibertyKey::ReceiverCapacitance1Rise},
+        {"receiver_capacitance2_fall", LibertyKey::ReceiverCapacitance2Fall},
+        {"receiver_capacitance2_rise", LibertyKey::ReceiverCapacitance2Rise},
+        {"related_pin", LibertyKey::RelatedPin},
+        {"rise_constraint", LibertyKey::RiseConstraint},
+        {"rise_power", LibertyKey::RisePower},
+        {"rise_transition", LibertyKey::RiseTransition},
+        {"timing", LibertyKey::Timing},
+        {"timing_sense", LibertyKey::TimingSense},
+        {"values", LibertyKey::Values},
+        {"vector", LibertyKey::Vector},
+    };
+    for (_seed = 0;; ++_seed) {
+        _table.fill({string_view(), LibertyKey::Unknown});
+        bool perfect = true;
+        for (const pair<string_view, LibertyKey>& keyword : keywords) {
+            pair<string_view, LibertyKey>& entry = _table[hash(keyword.first, _seed)];
+            if (entry.second != LibertyKey::Unknown) {
+                perfect = false;
+                break;
+            }
+            entry = keyword;
+        }
+        if (perfect) return;
+    }
+}
+
+/***** LibertyContext *****/
+
+namespace {
+inline bool isDigit(const char c) { return c >= '0' && c <= '9'; }
+inline bool isSign(const char c) { return c == '+' || c == '-'; }
+inline bool isWord(const char c) {
+    return (c >= 'A' && c <= 'Z') || (c >= 'a' && c <= 'z') || isDigit(c) || c == '_' || c == '.' || c == '-' ||
+           c == '!' || c == '&';
+}
+}  // namespace
+
+LibertyKey LibertyContext::key(const string_view name) {
+    static const LibertyKeywords keywords;
+    return keywords.find(name);
+}
+
+double LibertyContext::toDouble(string_view token) {
+    //  same result as atof: a single optional sign, then the longest valid prefix
+    bool negative = false;
+    if (!token.empty() && isSign(token.front())) {
+        negative = token.front() == '-';
+        token.remove_prefix(1);
+        if (!token.empty() && isSign(token.front())) return 0.0;
+    }
+    double value = 0.0;
+    std::from_chars(token.data(), token.data() + token.size(), value);
+    return negative ? -value : value;
+}
+
+//  ([0-9]+:)+[0-9]+
+unsigned LibertyContext::matchColon(const char* p) const {
+    const char* q = p;
+    unsigned len = 0;
+    bool colon = false;
+    while (isDigit(at(q))) {
+        while (isDigit(at(q))) ++q;
+        if (colon) len = q - p;
+        if (at(q) != ':') break;
+        ++q;
+        colon = true;
+    }
+    return len;
+}
+
+//  [\+\-]*[0-9]+(\.[0-9]*)*([Ee][\+\-]{0,1}[0-9]*)*
+unsigned LibertyContext::matchNumber(const char* p) const {
+    const char* q = p;
+    while (isSign(at(q))) ++q;
+    if (!isDigit(at(q))) return 0;
+    while (isDigit(at(q))) ++q;
+    while (at(q) == '.') {
+        ++q;
+        while (isDigit(at(q))) ++q;
+    }
+    while (at(q) == 'E' || at(q) == 'e') {
+        ++q;
+        if (isSign(at(q))) ++q;
+        while (isDigit(at(q))) ++q;
+    }
+    return q - p;
+}
+
+//  words of [A-Za-z0-9_\.\-!&] or "(c)" separated by single spaces
+unsigned LibertyContext::matchString(const char* p) const {
+    const auto word = [this](const char* q) -> const char* {
+        if (isWord(at(q))) {
+            while (isWord(at(q))) ++q;
+            return q;
+        }
+        if (at(q) == '(' && at(q + 1) == 'c' && at(q + 2) == ')') return q + 3;
+        return q;
+    };
+    const char* q = word(p);
+    if (q == p) return 0;
+    while (at(q) == ' ') {
+        const char* next = word(q + 1);
+        if (next == q + 1) break;
+        q = next;
+    }
+    return q - p;
+}
+
+//  \"([^,;\\\"]|\\.|,\\\n)+\"
+unsigned LibertyContext::matchQuoted(const char* p) const {
+    const char* q = p + 1;
+    while (q < _end) {
+        switch (*q) {
+            case '"':
+                return q - p > 1 ? q + 1 - p : 0;
+            case ';':
+                return 0;
+            case ',':
+                if (at(q + 1) != '\\' || at(q + 2) != '\n') return 0;
+                q += 3;
+                break;
+            case '\\':
+                if (q + 1 >= _end || q[1] == '\n') return 0;
+                q += 2;
+                break;
+            default:
+                ++q;
+        }
+    }
+    return 0;
+}
+
+int LibertyContext::lex(LibertyValue& value) {
+    while (_pos < _end) {
+        const char* p = _pos;
+        const char c = *p;
+        unsigned len = 1;
+        int token = 0;
+        if (c == '/' && (at(p + 1) == '*' || at(p + 1) == '/')) {
+            const char* q = nullptr;
+            if (at(p + 1) == '*') {
+                q = static_cast<const char*>(memmem(p + 2, _end - p - 2, "*/", 2));
+                q = q ? q + 2 : _end;
+            } else {
+                q = static_cast<const char*>(memchr(p + 2, '\n', _end - p - 2));
+                q = q ? q + 1 : _end;
+            }
+            line += count(p, q, '\n');
+            _pos = q;
+            continue;
+        } else if ((c == ' ' || c == '\t') && at(p + 1) == ':' && (at(p + 2) == ' ' || at(p + 2) == '\t')) {
+            len = 3;
+            token = ':';
+        } else if (c == ' ' || c == '\t' || c == '\n' || c == '\\') {
+        } else if (c == '"') {
+            const unsigned number = matchNumber(p + 1);
+            const unsigned lenNumber = number && at(p + 1 + number) == '"' ? number + 2 : 0;
+            const unsigned lenString = matchQuoted(p);
+            if (lenNumber && lenNumber >= lenString) {
+                len = lenNumber;
+                token = NUMBER;
+                value.dval = toDouble(string_view(p + 1, number));
+            } else if (lenString) {
+                len = lenString;
+                token = STRING;
+                value.sval = string_view(p + 1, lenString - 2);
+            }
+        } else if (c && strchr("(){},;'", c) && !matchString(p)) {
+            token = c;
+        } else {
+            //  longest match; on a tie the earlier rule of the former scanner wins
+            const unsigned lenColon = matchColon(p);
+            const unsigned lenNumber = matchNumber(p);
+            const unsigned lenOperator = c && strchr("+-*/", c) ? 1 : 0;
+            const unsigned lenString = matchString(p);
+            len = max({lenColon, lenNumber, lenOperator, lenString});
+            if (!len) {
+                len = 1;
+            } else if (len == lenColon) {
+                token = STRING;
+                value.sval = string_view(p, len);
+            } else if (len == lenNumber) {
+                token = NUMBER;
+                value.dval = toDouble(string_view(p, len));
+            } else if (len == lenOperator) {
+                token = c;
+            } else {
+                token = STRING;
+                value.sval = string_view(p, len);
+            }
+        }
+        line += count(p, p + len, '\n');
+        _pos = p + len;
+        if (token) return token;
+    }
+    return 0;
+}
+
+void LibertyContext::error(const char* msg) {
+    printlog(LOG_ERROR, "%s:%u: %s", file.c_str(), line, msg);
+    failed = true;
+}
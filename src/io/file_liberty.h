@@ -0,0 +1,132 @@
+#ifndef _IO_FILE_LIBERTY_H_
+#define _IO_FILE_LIBERTY_H_
+
+#include <array>
+
+#include "../db/db.h"
+#include "../sta/sta.h"
+
+namespace io {
+//  Attribute and group names the Liberty reader acts on
+enum class LibertyKey : unsigned char {
+    Unknown,
+    CapacitiveLoadUnit,
+    Capacitance,
+    Cell,
+    CellFall,
+    CellRise,
+    Direction,
+    DriveStrength,
+    FallConstraint,
+    FallPower,
+    FallTransition,
+    Index1,
+    Index2,
+    Index3,
+    Library,
+    LuTableTemplate,
+    MaxCapacitance,
+    MinCapacitance,
+    Pin,
+    PowerLutTemplate,
+    ReceiverCapacitance1Fall,
+    ReceiverCapacitance1Rise,
+    ReceiverCapacitance2Fall,
+    ReceiverCapacitance2Rise,
+    RelatedPin,
+    RiseConstraint,
+    RisePower,
+    RiseTransition,
+    Timing,
+    TimingSense,
+    Values,
+    Vector
+};
+
+//  Perfect hash of the Liberty keywords: the seed is searched once so that every keyword owns a slot,
+//  then a lookup is one hash and one comparison.
+class LibertyKeywords {
+private:
+    static constexpr unsigned TableSize = 256;
+
+    unsigned _seed = 0;
+    std::array<pair<string_view, LibertyKey>, TableSize> _table;
+
+    static unsigned hash(const string_view name, const unsigned seed) {
+        unsigned h = 2166136261u ^ seed;
+        for (const char c : name) h = (h ^ static_cast<unsigned char>(c)) * 16777619u;
+        return (h ^ (h >> 15)) & (TableSize - 1);
+    }
+
+public:
+    LibertyKeywords();
+
+    LibertyKey find(const string_view name) const {
+        const pair<string_view, LibertyKey>& entry = _table[hash(name, _seed)];
+        return entry.first == name ? entry.second : LibertyKey::Unknown;
+    }
+};
+
+//  Cells of one Liberty file as parsed, before they are bound to the cell types of the LEF
+struct LibertyCells {
+    string library;
+    double capacitanceUnit = 1.0;
+    vector<sta::STALibraryCell> cells;
+};
+
+//  Parse `file` into `liberty`, touching no other state, so that several files can be parsed at the same time;
+//  Database::readLiberty binds the result to the database alone
+bool parseLiberty(const string& file, LibertyCells& liberty);
+
+//  Binary cache of LibertyCells, valid while the size, modification time or content hash of `file` match.
+//  `dir` holds the caches of all Liberty files.
+string libertyCachePath(const string& dir, const string& file);
+bool readLibertyCache(const string& cache, const string& file, LibertyCells& liberty);
+bool writeLibertyCache(const string& cache, const string& file, const LibertyCells& liberty);
+
+struct LibertyValue {
+    double dval = 0.0;
+    string_view sval;
+};
+
+//  All the state of one Liberty parse, so that libraries can be parsed concurrently
+class LibertyContext {
+private:
+    const char* _pos;
+    const char* const _end;
+
+    char at(const char* p) const { return p < _end ? *p : '\0'; }
+    unsigned matchColon(const char* p) const;
+    unsigned matchNumber(const char* p) const;
+    unsigned matchString(const char* p) const;
+    unsigned matchQuoted(const char* p) const;
+
+public:
+    LibertyCells& liberty;
+    const string& file;
+    unsigned line = 1;
+    bool failed = false;
+
+    string lutTemplate;
+    char pindir = 'x';
+    sta::STALibraryTiming timing;
+    sta::STALibraryIPin ipin;
+    sta::STALibraryOPin opin;
+    sta::STALibraryCell cell;
+    sta::STALibraryLUT lut;
+    vector<string_view> svalues;
+    vector<double> dvalues;
+
+    LibertyContext(LibertyCells& liberty, const string& file, const char* begin, const char* end)
+        : _pos(begin), _end(end), liberty(liberty), file(file) {}
+
+    static LibertyKey key(const string_view name);
+    static double toDouble(const string_view token);
+
+    //  next token, with the same rules as the former flex scanner; 0 at the end of input
+    int lex(LibertyValue& value);
+    void error(const char* msg);
+};
+}  // namespace io
+
+#endif
@@ -1,8 +1,9 @@
-/* A Bison parser, made by GNU Bison 3.1.  */
+/* A Bison parser, made by GNU Bison 3.8.2.  */
 
 /* Bison implementation for Yacc-like parsers in C
 
-   Copyright (C) 1984, 1989-1990, 2000-2015, 2018 Free Software Foundation, Inc.
+   Copyright (C) 1984, 1989-1990, 2000-2015, 2018-2021 Free Software Foundation,
+   Inc.
 
    This program is free software: you can redistribute it and/or modify
    it under the terms of the GNU General Public License as published by
@@ -15,7 +16,7 @@
    GNU General Public License for more details.
 
    You should have received a copy of the GNU General Public License
-   along with this program.  If not, see <http://www.gnu.org/licenses/>.  */
+   along with this program.  If not, see <https://www.gnu.org/licenses/>.  */
 
 /* As a special exception, you may create a larger work that contains
    part or all of the Bison parser skeleton and distribute that work
@@ -33,6 +34,10 @@
 /* C LALR(1) parser skeleton written by Richard Stallman, by
    simplifying the original so-called "semantic" parser.  */
 
+/* DO NOT RELY ON FEATURES THAT ARE NOT DOCUMENTED in the manual,
+   especially those whose name start with YY_ or yy_.  They are
+   private implementation details that can be changed or removed.  */
+
 /* All symbols defined below should begin with yy or YY, to avoid
    infringing on user name space.  This should be done even for local
    variables, as they might otherwise be expanded by user macros.
@@ -40,17 +45,17 @@
    define necessary library symbols; they are noted "INFRINGES ON
    USER NAME SPACE" below.  */
 
-/* Identify Bison output.  */
-#define YYBISON 1
+/* Identify Bison output, and Bison version.  */
+#define YYBISON 30802
 
-/* Bison version.  */
-#define YYBISON_VERSION "3.1"
+/* Bison version string.  */
+#define YYBISON_VERSION "3.8.2"
 
 /* Skeleton name.  */
 #define YYSKELETON_NAME "yacc.c"
 
 /* Pure parsers.  */
-#define YYPURE 0
+#define YYPURE 2
 
 /* Push parsers.  */
 #define YYPUSH 0
@@ -66,156 +71,169 @@
 #define yydebug         file_libertydebug
 #define yynerrs         file_libertynerrs
 
-#define yylval          file_libertylval
-#define yychar          file_libertychar
-#define yylloc          file_libertylloc
-
-/* Copy the first part of user declarations.  */
-#line 1 "io/file_liberty.y" /* yacc.c:339  */
-
-
-#include "../db/db.h"
-#include "../global.h"
-#include "../sta/sta.h"
-
-using namespace db;
-using namespace sta;
-
-#define yylex   file_libertylex
-#define yyparse file_libertyparse
-#define yyin    file_libertyin
-#define yyerror file_libertyerror
-
-extern "C" int yylex();
-extern "C" int yyparse();
-extern "C" FILE *yyin;
-
-STALibrary *stalib;
-string lutTemplate;
-char pindir='x';
-STALibraryTiming timing;
-STALibraryIPin ipin;
-STALibraryOPin opin;
-STALibraryCell cell;
-STALibraryLUT lut;
-stack<string> svalues;
-vector<double> dvalues;
-
-//%define api.prefix {liberty}
-
-void yyerror(const char *s);
-
-
-#line 110 "file_liberty.tab.c" /* yacc.c:339  */
 
+# ifndef YY_CAST
+#  ifdef __cplusplus
+#   define YY_CAST(Type, Val) static_cast<Type> (Val)
+#   define YY_REINTERPRET_CAST(Type, Val) reinterpret_cast<Type> (Val)
+#  else
+#   define YY_CAST(Type, Val) ((Type) (Val))
+#   define YY_REINTERPRET_CAST(Type, Val) ((Type) (Val))
+#  endif
+# endif
 # ifndef YY_NULLPTR
-#  if defined __cplusplus && 201103L <= __cplusplus
-#   define YY_NULLPTR nullptr
+#  if defined __cplusplus
+#   if 201103L <= __cplusplus
+#    define YY_NULLPTR nullptr
+#   else
+#    define YY_NULLPTR 0
+#   endif
 #  else
-#   define YY_NULLPTR 0
+#   define YY_NULLPTR ((void*)0)
 #  endif
 # endif
 
-/* Enabling verbose error messages.  */
-#ifdef YYERROR_VERBOSE
-# undef YYERROR_VERBOSE
-# define YYERROR_VERBOSE 1
-#else
-# define YYERROR_VERBOSE 1
-#endif
-
-/* In a future release of Bison, this section will be replaced
-   by #include "file_liberty.tab.h".  */
-#ifndef YY_FILE_LIBERTY_FILE_LIBERTY_TAB_H_INCLUDED
-# define YY_FILE_LIBERTY_FILE_LIBERTY_TAB_H_INCLUDED
-/* Debug traces.  */
-#ifndef YYDEBUG
-# define YYDEBUG 0
-#endif
-#if YYDEBUG
-extern int file_libertydebug;
-#endif
-
-/* Token type.  */
-#ifndef YYTOKENTYPE
-# define YYTOKENTYPE
-  enum yytokentype
-  {
-    NUMBER = 258,
-    STRING = 259
-  };
-#endif
+#include "file_liberty.tab.h"
+/* Symbol kind.  */
+enum yysymbol_kind_t
+{
+  YYSYMBOL_YYEMPTY = -2,
+  YYSYMBOL_YYEOF = 0,                      /* "end of file"  */
+  YYSYMBOL_YYerror = 1,                    /* error  */
+  YYSYMBOL_YYUNDEF = 2,                    /* "invalid token"  */
+  YYSYMBOL_NUMBER = 3,                     /* NUMBER  */
+  YYSYMBOL_STRING = 4,                     /* STRING  */
+  YYSYMBOL_5_ = 5,                         /* ':'  */
+  YYSYMBOL_6_ = 6,                         /* ';'  */
+  YYSYMBOL_7_ = 7,                         /* '('  */
+  YYSYMBOL_8_ = 8,                         /* ')'  */
+  YYSYMBOL_9_ = 9,                         /* ','  */
+  YYSYMBOL_10_ = 10,                       /* '{'  */
+  YYSYMBOL_11_ = 11,                       /* '}'  */
+  YYSYMBOL_YYACCEPT = 12,                  /* $accept  */
+  YYSYMBOL_liberty = 13,                   /* liberty  */
+  YYSYMBOL_statements = 14,                /* statements  */
+  YYSYMBOL_statement = 15,                 /* statement  */
+  YYSYMBOL_simple_attribute = 16,          /* simple_attribute  */
+  YYSYMBOL_complex_attribute = 17,         /* complex_attribute  */
+  YYSYMBOL_value_list = 18,                /* value_list  */
+  YYSYMBOL_value = 19,                     /* value  */
+  YYSYMBOL_group = 20                      /* group  */
+};
+typedef enum yysymbol_kind_t yysymbol_kind_t;
 
-/* Value type.  */
-#if ! defined YYSTYPE && ! defined YYSTYPE_IS_DECLARED
 
-union YYSTYPE
-{
-#line 40 "io/file_liberty.y" /* yacc.c:355  */
 
-    double  dval;
-    char *  sval;
-    int     token;
+/* Unqualified %code blocks.  */
+#line 14 "io/file_liberty.y"
 
-#line 161 "file_liberty.tab.c" /* yacc.c:355  */
-};
 
-typedef union YYSTYPE YYSTYPE;
-# define YYSTYPE_IS_TRIVIAL 1
-# define YYSTYPE_IS_DECLARED 1
-#endif
+#include "../global.h"
+#include "io.h"
+#include "utils.h"
 
-/* Location type.  */
-#if ! defined YYLTYPE && ! defined YYLTYPE_IS_DECLARED
-typedef struct YYLTYPE YYLTYPE;
-struct YYLTYPE
-{
-  int first_line;
-  int first_column;
-  int last_line;
-  int last_column;
-};
-# define YYLTYPE_IS_DECLARED 1
-# define YYLTYPE_IS_TRIVIAL 1
-#endif
+using namespace db;
+using namespace io;
+using namespace sta;
 
+//  attribute and group names are dispatched through the perfect hash in LibertyContext::key
 
-extern YYSTYPE file_libertylval;
-extern YYLTYPE file_libertylloc;
-int file_libertyparse (void);
+int yylex(YYSTYPE* value, YYLTYPE* location, LibertyContext& ctx) {
+    const int token = ctx.lex(*value);
+    location->first_line = location->last_line = ctx.line;
+    return token;
+}
 
-#endif /* !YY_FILE_LIBERTY_FILE_LIBERTY_TAB_H_INCLUDED  */
+void yyerror(YYLTYPE* location, LibertyContext& ctx, const char* s) { ctx.error(s); }
 
-/* Copy the second part of user declarations.  */
 
-#line 192 "file_liberty.tab.c" /* yacc.c:358  */
+#line 151 "file_liberty.tab.c"
 
 #ifdef short
 # undef short
 #endif
 
-#ifdef YYTYPE_UINT8
-typedef YYTYPE_UINT8 yytype_uint8;
-#else
-typedef unsigned char yytype_uint8;
+/* On compilers that do not define __PTRDIFF_MAX__ etc., make sure
+   <limits.h> and (if available) <stdint.h> are included
+   so that the code can choose integer types of a good width.  */
+
+#ifndef __PTRDIFF_MAX__
+# include <limits.h> /* INFRINGES ON USER NAME SPACE */
+# if defined __STDC_VERSION__ && 199901 <= __STDC_VERSION__
+#  include <stdint.h> /* INFRINGES ON USER NAME SPACE */
+#  define YY_STDINT_H
+# endif
 #endif
 
-#ifdef YYTYPE_INT8
-typedef YYTYPE_INT8 yytype_int8;
+/* Narrow types that promote to a signed type and that can represent a
+   signed or unsigned integer of at least N bits.  In tables they can
+   save space and decrease cache pressure.  Promoting to a signed type
+   helps avoid bugs in integer arithmetic.  */
+
+#ifdef __INT_LEAST8_MAX__
+typedef __INT_LEAST8_TYPE__ yytype_int8;
+#elif defined YY_STDINT_H
+typedef int_least8_t yytype_int8;
 #else
 typedef signed char yytype_int8;
 #endif
 
-#ifdef YYTYPE_UINT16
-typedef YYTYPE_UINT16 yytype_uint16;
+#ifdef __INT_LEAST16_MAX__
+typedef __INT_LEAST16_TYPE__ yytype_int16;
+#elif defined YY_STDINT_H
+typedef int_least16_t yytype_int16;
 #else
-typedef unsigned short yytype_uint16;
+typedef short yytype_int16;
+#endif
+
+/* Work around bug in HP-UX 11.23, which defines these macros
+   incorrectly for preprocessor constants.  This workaround can likely
+   be removed in 2023, as HPE has promised support for HP-UX 11.23
+   (aka HP-UX 11i v2) only through the end of 2022; see Table 2 of
+   <https://h20195.www2.hpe.com/V2/getpdf.aspx/4AA4-7673ENW.pdf>.  */
+#ifdef __hpux
+# undef UINT_LEAST8_MAX
+# undef UINT_LEAST16_MAX
+# define UINT_LEAST8_MAX 255
+# define UINT_LEAST16_MAX 65535
 #endif
 
-#ifdef YYTYPE_INT16
-typedef YYTYPE_INT16 yytype_int16;
+#if defined __UINT_LEAST8_MAX__ && __UINT_LEAST8_MAX__ <= __INT_MAX__
+typedef __UINT_LEAST8_TYPE__ yytype_uint8;
+#elif (!defined __UINT_LEAST8_MAX__ && defined YY_STDINT_H \
+       && UINT_LEAST8_MAX <= INT_MAX)
+typedef uint_least8_t yytype_uint8;
+#elif !defined __UINT_LEAST8_MAX__ && UCHAR_MAX <= INT_MAX
+typedef unsigned char yytype_uint8;
 #else
-typedef short yytype_int16;
+typedef short yytype_uint8;
+#endif
+
+#if defined __UINT_LEAST16_MAX__ && __UINT_LEAST16_MAX__ <= __INT_MAX__
+typedef __UINT_LEAST16_TYPE__ yytype_uint16;
+#elif (!defined __UINT_LEAST16_MAX__ && defined YY_STDINT_H \
+       && UINT_LEAST16_MAX <= INT_MAX)
+typedef uint_least16_t yytype_uint16;
+#elif !defined __UINT_LEAST16_MAX__ && USHRT_MAX <= INT_MAX
+typedef unsigned short yytype_uint16;
+#else
+typedef int yytype_uint16;
+#endif
+
+#ifndef YYPTRDIFF_T
+# if defined __PTRDIFF_TYPE__ && defined __PTRDIFF_MAX__
+#  define YYPTRDIFF_T __PTRDIFF_TYPE__
+#  define YYPTRDIFF_MAXIMUM __PTRDIFF_MAX__
+# elif defined PTRDIFF_MAX
+#  ifndef ptrdiff_t
+#   include <stddef.h> /* INFRINGES ON USER NAME SPACE */
+#  endif
+#  define YYPTRDIFF_T ptrdiff_t
+#  define YYPTRDIFF_MAXIMUM PTRDIFF_MAX
+# else
+#  define YYPTRDIFF_T long
+#  define YYPTRDIFF_MAXIMUM LONG_MAX
+# endif
 #endif
 
 #ifndef YYSIZE_T
@@ -223,7 +241,7 @@ typedef short yytype_int16;
 #  define YYSIZE_T __SIZE_TYPE__
 # elif defined size_t
 #  define YYSIZE_T size_t
-# elif ! defined YYSIZE_T
+# elif defined __STDC_VERSION__ && 199901 <= __STDC_VERSION__
 #  include <stddef.h> /* INFRINGES ON USER NAME SPACE */
 #  define YYSIZE_T size_t
 # else
@@ -231,7 +249,20 @@ typedef short yytype_int16;
 # endif
 #endif
 
-#define YYSIZE_MAXIMUM ((YYSIZE_T) -1)
+#define YYSIZE_MAXIMUM                                  \
+  YY_CAST (YYPTRDIFF_T,                                 \
+           (YYPTRDIFF_MAXIMUM < YY_CAST (YYSIZE_T, -1)  \
+            ? YYPTRDIFF_MAXIMUM                         \
+            : YY_CAST (YYSIZE_T, -1)))
+
+#define YYSIZEOF(X) YY_CAST (YYPTRDIFF_T, sizeof (X))
+
+
+/* Stored state numbers (used for stacks). */
+typedef yytype_int8 yy_state_t;
+
+/* State numbers in computations.  */
+typedef int yy_state_fast_t;
 
 #ifndef YY_
 # if defined YYENABLE_NLS && YYENABLE_NLS
@@ -245,47 +276,43 @@ typedef short yytype_int16;
 # endif
 #endif
 
-#ifndef YY_ATTRIBUTE
-# if (defined __GNUC__                                               \
-      && (2 < __GNUC__ || (__GNUC__ == 2 && 96 <= __GNUC_MINOR__)))  \
-     || defined __SUNPRO_C && 0x5110 <= __SUNPRO_C
-#  define YY_ATTRIBUTE(Spec) __attribute__(Spec)
-# else
-#  define YY_ATTRIBUTE(Spec) /* empty */
-# endif
-#endif
 
 #ifndef YY_ATTRIBUTE_PURE
-# define YY_ATTRIBUTE_PURE   YY_ATTRIBUTE ((__pure__))
+# if defined __GNUC__ && 2 < __GNUC__ + (96 <= __GNUC_MINOR__)
+#  define YY_ATTRIBUTE_PURE __attribute__ ((__pure__))
+# else
+#  define YY_ATTRIBUTE_PURE
+# endif
 #endif
 
 #ifndef YY_ATTRIBUTE_UNUSED
-# define YY_ATTRIBUTE_UNUSED YY_ATTRIBUTE ((__unused__))
-#endif
-
-#if !defined _Noreturn \
-     && (!defined __STDC_VERSION__ || __STDC_VERSION__ < 201112)
-# if defined _MSC_VER && 1200 <= _MSC_VER
-#  define _Noreturn __declspec (noreturn)
+# if defined __GNUC__ && 2 < __GNUC__ + (7 <= __GNUC_MINOR__)
+#  define YY_ATTRIBUTE_UNUSED __attribute__ ((__unused__))
 # else
-#  define _Noreturn YY_ATTRIBUTE ((__noreturn__))
+#  define YY_ATTRIBUTE_UNUSED
 # endif
 #endif
 
 /* Suppress unused-variable warnings by "using" E.  */
 #if ! defined lint || defined __GNUC__
-# define YYUSE(E) ((void) (E))
+# define YY_USE(E) ((void) (E))
 #else
-# define YYUSE(E) /* empty */
+# define YY_USE(E) /* empty */
 #endif
 
-#if defined __GNUC__ && ! defined __ICC && 407 <= __GNUC__ * 100 + __GNUC_MINOR__
 /* Suppress an incorrect diagnostic about yylval being uninitialized.  */
-# define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN \
-    _Pragma ("GCC diagnostic push") \
-    _Pragma ("GCC diagnostic ignored \"-Wuninitialized\"")\
+#if defined __GNUC__ && ! defined __ICC && 406 <= __GNUC__ * 100 + __GNUC_MINOR__
+# if __GNUC__ * 100 + __GNUC_MINOR__ < 407
+#  define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN                           \
+    _Pragma ("GCC diagnostic push")                                     \
+    _Pragma ("GCC diagnostic ignored \"-Wuninitialized\"")
+# else
+#  define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN                           \
+    _Pragma ("GCC diagnostic push")                                     \
+    _Pragma ("GCC diagnostic ignored \"-Wuninitialized\"")              \
     _Pragma ("GCC diagnostic ignored \"-Wmaybe-uninitialized\"")
-# define YY_IGNORE_MAYBE_UNINITIALIZED_END \
+# endif
+# define YY_IGNORE_MAYBE_UNINITIALIZED_END      \
     _Pragma ("GCC diagnostic pop")
 #else
 # define YY_INITIAL_VALUE(Value) Value
@@ -298,6 +325,20 @@ typedef short yytype_int16;
 # define YY_INITIAL_VALUE(Value) /* Nothing. */
 #endif
 
+#if defined __cplusplus && defined __GNUC__ && ! defined __ICC && 6 <= __GNUC__
+# define YY_IGNORE_USELESS_CAST_BEGIN                          \
+    _Pragma ("GCC diagnostic push")                            \
+    _Pragma ("GCC diagnostic ignored \"-Wuseless-cast\"")
+# define YY_IGNORE_USELESS_CAST_END            \
+    _Pragma ("GCC diagnostic pop")
+#endif
+#ifndef YY_IGNORE_USELESS_CAST_BEGIN
+# define YY_IGNORE_USELESS_CAST_BEGIN
+# define YY_IGNORE_USELESS_CAST_END
+#endif
+
+
+#define YY_ASSERT(E) ((void) (0 && (E)))
 
 #if 1
 
@@ -341,8 +382,7 @@ void free (void *); /* INFRINGES ON USER NAME SPACE */
 #  endif
 # endif
 # define YYCOPY_NEEDED 1
-#endif
-
+#endif /* 1 */
 
 #if (! defined yyoverflow \
      && (! defined __cplusplus \
@@ -352,18 +392,19 @@ void free (void *); /* INFRINGES ON USER NAME SPACE */
 /* A type that is properly aligned for any stack member.  */
 union yyalloc
 {
-  yytype_int16 yyss_alloc;
+  yy_state_t yyss_alloc;
   YYSTYPE yyvs_alloc;
   YYLTYPE yyls_alloc;
 };
 
 /* The size of the maximum gap between one aligned stack and the next.  */
-# define YYSTACK_GAP_MAXIMUM (sizeof (union yyalloc) - 1)
+# define YYSTACK_GAP_MAXIMUM (YYSIZEOF (union yyalloc) - 1)
 
 /* The size of an array large to enough to hold all stacks, each with
    N elements.  */
 # define YYSTACK_BYTES(N) \
-     ((N) * (sizeof (yytype_int16) + sizeof (YYSTYPE) + sizeof (YYLTYPE)) \
+     ((N) * (YYSIZEOF (yy_state_t) + YYSIZEOF (YYSTYPE) \
+             + YYSIZEOF (YYLTYPE)) \
       + 2 * YYSTACK_GAP_MAXIMUM)
 
 # define YYCOPY_NEEDED 1
@@ -376,11 +417,11 @@ union yyalloc
 # define YYSTACK_RELOCATE(Stack_alloc, Stack)                           \
     do                                                                  \
       {                                                                 \
-        YYSIZE_T yynewbytes;                                            \
+        YYPTRDIFF_T yynewbytes;                                         \
         YYCOPY (&yyptr->Stack_alloc, Stack, yysize);                    \
         Stack = &yyptr->Stack_alloc;                                    \
-        yynewbytes = yystacksize * sizeof (*Stack) + YYSTACK_GAP_MAXIMUM; \
-        yyptr += yynewbytes / sizeof (*yyptr);                          \
+        yynewbytes = yystacksize * YYSIZEOF (*Stack) + YYSTACK_GAP_MAXIMUM; \
+        yyptr += yynewbytes / YYSIZEOF (*yyptr);                        \
       }                                                                 \
     while (0)
 
@@ -392,12 +433,12 @@ union yyalloc
 # ifndef YYCOPY
 #  if defined __GNUC__ && 1 < __GNUC__
 #   define YYCOPY(Dst, Src, Count) \
-      __builtin_memcpy (Dst, Src, (Count) * sizeof (*(Src)))
+      __builtin_memcpy (Dst, Src, YY_CAST (YYSIZE_T, (Count)) * sizeof (*(Src)))
 #  else
 #   define YYCOPY(Dst, Src, Count)              \
       do                                        \
         {                                       \
-          YYSIZE_T yyi;                         \
+          YYPTRDIFF_T yyi;                      \
           for (yyi = 0; yyi < (Count); yyi++)   \
             (Dst)[yyi] = (Src)[yyi];            \
         }                                       \
@@ -420,17 +461,20 @@ union yyalloc
 /* YYNSTATES -- Number of states.  */
 #define YYNSTATES  49
 
-/* YYTRANSLATE[YYX] -- Symbol number corresponding to YYX as returned
-   by yylex, with out-of-bounds checking.  */
-#define YYUNDEFTOK  2
+/* YYMAXUTOK -- Last valid token kind.  */
 #define YYMAXUTOK   259
 
-#define YYTRANSLATE(YYX)                                                \
-  ((unsigned) (YYX) <= YYMAXUTOK ? yytranslate[YYX] : YYUNDEFTOK)
+
+/* YYTRANSLATE(TOKEN-NUM) -- Symbol number corresponding to TOKEN-NUM
+   as returned by yylex, with out-of-bounds checking.  */
+#define YYTRANSLATE(YYX)                                \
+  (0 <= (YYX) && (YYX) <= YYMAXUTOK                     \
+   ? YY_CAST (yysymbol_kind_t, yytranslate[YYX])        \
+   : YYSYMBOL_YYUNDEF)
 
 /* YYTRANSLATE[TOKEN-NUM] -- Symbol number corresponding to TOKEN-NUM
-   as returned by yylex, without out-of-bounds checking.  */
-static const yytype_uint8 yytranslate[] =
+   as returned by yylex.  */
+static const yytype_int8 yytranslate[] =
 {
        0,     2,     2,     2,     2,     2,     2,     2,     2,     2,
        2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
@@ -461,49 +505,52 @@ static const yytype_uint8 yytranslate[] =
 };
 
 #if YYDEBUG
-  /* YYRLINE[YYN] -- Source line where rule number YYN was defined.  */
-static const yytype_uint16 yyrline[] =
+/* YYRLINE[YYN] -- Source line where rule number YYN was defined.  */
+static const yytype_int16 yyrline[] =
 {
-       0,    51,    51,    53,    55,    58,    59,    60,    63,   138,
-     182,   190,   196,   212,   253,   254,   257,   258,   261,   273,
-     406
+       0,    41,    41,    43,    45,    48,    49,    50,    53,    84,
+     102,   105,   106,   127,   175,   176,   179,   180,   183,   188,
+     280
 };
 #endif
 
-#if YYDEBUG || YYERROR_VERBOSE || 1
+/** Accessing symbol of state STATE.  */
+#define YY_ACCESSING_SYMBOL(State) YY_CAST (yysymbol_kind_t, yystos[State])
+
+#if 1
+/* The user-facing name of the symbol whose (internal) number is
+   YYSYMBOL.  No bounds checking.  */
+static const char *yysymbol_name (yysymbol_kind_t yysymbol) YY_ATTRIBUTE_UNUSED;
+
 /* YYTNAME[SYMBOL-NUM] -- String name of the symbol SYMBOL-NUM.
    First, the terminals, then, starting at YYNTOKENS, nonterminals.  */
 static const char *const yytname[] =
 {
-  "$end", "error", "$undefined", "NUMBER", "STRING", "':'", "';'", "'('",
-  "')'", "','", "'{'", "'}'", "$accept", "liberty", "statements",
-  "statement", "simple_attribute", "complex_attribute", "value_list",
-  "value", "group", YY_NULLPTR
+  "\"end of file\"", "error", "\"invalid token\"", "NUMBER", "STRING",
+  "':'", "';'", "'('", "')'", "','", "'{'", "'}'", "$accept", "liberty",
+  "statements", "statement", "simple_attribute", "complex_attribute",
+  "value_list", "value", "group", YY_NULLPTR
 };
-#endif
 
-# ifdef YYPRINT
-/* YYTOKNUM[NUM] -- (External) token number corresponding to the
-   (internal) symbol number NUM (which must be that of a token).  */
-static const yytype_uint16 yytoknum[] =
+static const char *
+yysymbol_name (yysymbol_kind_t yysymbol)
 {
-       0,   256,   257,   258,   259,    58,    59,    40,    41,    44,
-     123,   125
-};
-# endif
+  return yytname[yysymbol];
+}
+#endif
 
-#define YYPACT_NINF -6
+#define YYPACT_NINF (-6)
 
-#define yypact_value_is_default(Yystate) \
-  (!!((Yystate) == (-6)))
+#define yypact_value_is_default(Yyn) \
+  ((Yyn) == YYPACT_NINF)
 
-#define YYTABLE_NINF -1
+#define YYTABLE_NINF (-1)
 
-#define yytable_value_is_error(Yytable_value) \
+#define yytable_value_is_error(Yyn) \
   0
 
-  /* YYPACT[STATE-NUM] -- Index in YYTABLE of the portion describing
-     STATE-NUM.  */
+/* YYPACT[STATE-NUM] -- Index in YYTABLE of the portion describing
+   STATE-NUM.  */
 static const yytype_int8 yypact[] =
 {
       21,    31,    14,    -6,     2,    -6,    -6,    19,    29,    -5,
@@ -513,10 +560,10 @@ static const yytype_int8 yypact[] =
       -6,    -6,    -6,    39,     7,     9,    -6,    -6,    -6
 };
 
-  /* YYDEFACT[STATE-NUM] -- Default reduction number in state STATE-NUM.
-     Performed when YYTABLE does not specify something else to do.  Zero
-     means the default is an error.  */
-static const yytype_uint8 yydefact[] =
+/* YYDEFACT[STATE-NUM] -- Default reduction number in state STATE-NUM.
+   Performed when YYTABLE does not specify something else to do.  Zero
+   means the default is an error.  */
+static const yytype_int8 yydefact[] =
 {
        0,     0,     0,     2,     0,     1,    17,    16,     0,     0,
        0,     0,     3,     0,     0,     0,     3,     0,     3,    16,
@@ -525,22 +572,22 @@ static const yytype_uint8 yydefact[] =
        9,     8,    10,     0,     0,     0,    12,    11,    13
 };
 
-  /* YYPGOTO[NTERM-NUM].  */
+/* YYPGOTO[NTERM-NUM].  */
 static const yytype_int8 yypgoto[] =
 {
       -6,    -6,    10,    -6,    -6,    -6,     3,    22,    47
 };
 
-  /* YYDEFGOTO[NTERM-NUM].  */
+/* YYDEFGOTO[NTERM-NUM].  */
 static const yytype_int8 yydefgoto[] =
 {
-      -1,     2,    17,    25,    26,    27,     9,    10,    28
+       0,     2,    17,    25,    26,    27,     9,    10,    28
 };
 
-  /* YYTABLE[YYPACT[STATE-NUM]] -- What to do in state STATE-NUM.  If
-     positive, shift that token.  If negative, reduce the rule whose
-     number is the opposite.  If YYTABLE_NINF, syntax error.  */
-static const yytype_uint8 yytable[] =
+/* YYTABLE[YYPACT[STATE-NUM]] -- What to do in state STATE-NUM.  If
+   positive, shift that token.  If negative, reduce the rule whose
+   number is the opposite.  If YYTABLE_NINF, syntax error.  */
+static const yytype_int8 yytable[] =
 {
       23,    23,    23,    13,    14,     6,     7,    24,    30,    33,
        8,    37,    38,    47,     5,    48,     8,    16,    42,    18,
@@ -549,7 +596,7 @@ static const yytype_uint8 yytable[] =
       16,    40,    18,    41,    43,    46,    44,     3
 };
 
-static const yytype_uint8 yycheck[] =
+static const yytype_int8 yycheck[] =
 {
        4,     4,     4,     8,     9,     3,     4,    11,    11,    11,
        8,     3,     4,     6,     0,     6,     8,    10,     6,    10,
@@ -558,9 +605,9 @@ static const yytype_uint8 yycheck[] =
       10,     6,    10,     6,     8,     6,     8,     0
 };
 
-  /* YYSTOS[STATE-NUM] -- The (internal number of the) accessing
-     symbol of state STATE-NUM.  */
-static const yytype_uint8 yystos[] =
+/* YYSTOS[STATE-NUM] -- The symbol kind of the accessing symbol of
+   state STATE-NUM.  */
+static const yytype_int8 yystos[] =
 {
        0,     4,    13,    20,     7,     0,     3,     4,     8,    18,
       19,     8,    10,     8,     9,     9,    10,    14,    10,     4,
@@ -569,16 +616,16 @@ static const yytype_uint8 yystos[] =
        6,     6,     6,     8,     8,     8,     6,     6,     6
 };
 
-  /* YYR1[YYN] -- Symbol number of symbol that rule YYN derives.  */
-static const yytype_uint8 yyr1[] =
+/* YYR1[RULE-NUM] -- Symbol kind of the left-hand side of rule RULE-NUM.  */
+static const yytype_int8 yyr1[] =
 {
        0,    12,    13,    14,    14,    15,    15,    15,    16,    16,
       16,    17,    17,    17,    18,    18,    19,    19,    20,    20,
       20
 };
 
-  /* YYR2[YYN] -- Number of symbols on the right hand side of rule YYN.  */
-static const yytype_uint8 yyr2[] =
+/* YYR2[RULE-NUM] -- Number of symbols on the right-hand side of rule RULE-NUM.  */
+static const yytype_int8 yyr2[] =
 {
        0,     2,     1,     0,     2,     1,     1,     1,     4,     4,
        4,     5,     5,     5,     3,     3,     1,     1,     6,     7,
@@ -586,40 +633,40 @@ static const yytype_uint8 yyr2[] =
 };
 
 
+enum { YYENOMEM = -2 };
+
 #define yyerrok         (yyerrstatus = 0)
 #define yyclearin       (yychar = YYEMPTY)
-#define YYEMPTY         (-2)
-#define YYEOF           0
 
 #define YYACCEPT        goto yyacceptlab
 #define YYABORT         goto yyabortlab
 #define YYERROR         goto yyerrorlab
+#define YYNOMEM         goto yyexhaustedlab
 
 
 #define YYRECOVERING()  (!!yyerrstatus)
 
-#define YYBACKUP(Token, Value)                                  \
-do                                                              \
-  if (yychar == YYEMPTY)                                        \
-    {                                                           \
-      yychar = (Token);                                         \
-      yylval = (Value);                                         \
-      YYPOPSTACK (yylen);                                       \
-      yystate = *yyssp;                                         \
-      YY_LAC_DISCARD ("YYBACKUP");                              \
-      goto yybackup;                                            \
-    }                                                           \
-  else                                                          \
-    {                                                           \
-      yyerror (YY_("syntax error: cannot back up")); \
-      YYERROR;                                                  \
-    }                                                           \
-while (0)
-
-/* Error token number */
-#define YYTERROR        1
-#define YYERRCODE       256
-
+#define YYBACKUP(Token, Value)                                    \
+  do                                                              \
+    if (yychar == YYEMPTY)                                        \
+      {                                                           \
+        yychar = (Token);                                         \
+        yylval = (Value);                                         \
+        YYPOPSTACK (yylen);                                       \
+        yystate = *yyssp;                                         \
+        YY_LAC_DISCARD ("YYBACKUP");                              \
+        goto yybackup;                                            \
+      }                                                           \
+    else                                                          \
+      {                                                           \
+        yyerror (&yylloc, ctx, YY_("syntax error: cannot back up")); \
+        YYERROR;                                                  \
+      }                                                           \
+  while (0)
+
+/* Backward compatibility with an undocumented macro.
+   Use YYerror or YYUNDEF. */
+#define YYERRCODE YYUNDEF
 
 /* YYLLOC_DEFAULT -- Set CURRENT to span from RHS[1] to RHS[N].
    If N is 0, then set CURRENT to the empty location which ends
@@ -663,20 +710,27 @@ do {                                            \
 } while (0)
 
 
-/* YY_LOCATION_PRINT -- Print the location on the stream.
+/* YYLOCATION_PRINT -- Print the location on the stream.
    This macro was not mandated originally: define only if we know
    we won't break user code: when these are the locations we know.  */
 
-#ifndef YY_LOCATION_PRINT
-# if defined YYLTYPE_IS_TRIVIAL && YYLTYPE_IS_TRIVIAL
+# ifndef YYLOCATION_PRINT
+
+#  if defined YY_LOCATION_PRINT
+
+   /* Temporary convenience wrapper in case some people defined the
+      undocumented and private YY_LOCATION_PRINT macros.  */
+#   define YYLOCATION_PRINT(File, Loc)  YY_LOCATION_PRINT(File, *(Loc))
+
+#  elif defined YYLTYPE_IS_TRIVIAL && YYLTYPE_IS_TRIVIAL
 
 /* Print *YYLOCP on YYO.  Private, do not rely on its existence. */
 
 YY_ATTRIBUTE_UNUSED
-static unsigned
+static int
 yy_location_print_ (FILE *yyo, YYLTYPE const * const yylocp)
 {
-  unsigned res = 0;
+  int res = 0;
   int end_col = 0 != yylocp->last_column ? yylocp->last_column - 1 : 0;
   if (0 <= yylocp->first_line)
     {
@@ -696,63 +750,72 @@ yy_location_print_ (FILE *yyo, YYLTYPE const * const yylocp)
         res += YYFPRINTF (yyo, "-%d", end_col);
     }
   return res;
- }
+}
 
-#  define YY_LOCATION_PRINT(File, Loc)          \
-  yy_location_print_ (File, &(Loc))
+#   define YYLOCATION_PRINT  yy_location_print_
 
-# else
-#  define YY_LOCATION_PRINT(File, Loc) ((void) 0)
-# endif
-#endif
+    /* Temporary convenience wrapper in case some people defined the
+       undocumented and private YY_LOCATION_PRINT macros.  */
+#   define YY_LOCATION_PRINT(File, Loc)  YYLOCATION_PRINT(File, &(Loc))
 
+#  else
+
+#   define YYLOCATION_PRINT(File, Loc) ((void) 0)
+    /* Temporary convenience wrapper in case some people defined the
+       undocumented and private YY_LOCATION_PRINT macros.  */
+#   define YY_LOCATION_PRINT  YYLOCATION_PRINT
 
-# define YY_SYMBOL_PRINT(Title, Type, Value, Location)                    \
+#  endif
+# endif /* !defined YYLOCATION_PRINT */
+
+
+# define YY_SYMBOL_PRINT(Title, Kind, Value, Location)                    \
 do {                                                                      \
   if (yydebug)                                                            \
     {                                                                     \
       YYFPRINTF (stderr, "%s ", Title);                                   \
       yy_symbol_print (stderr,                                            \
-                  Type, Value, Location); \
+                  Kind, Value, Location, ctx); \
       YYFPRINTF (stderr, "\n");                                           \
     }                                                                     \
 } while (0)
 
 
-/*----------------------------------------.
-| Print this symbol's value on YYOUTPUT.  |
-`----------------------------------------*/
+/*-----------------------------------.
+| Print this symbol's value on YYO.  |
+`-----------------------------------*/
 
 static void
-yy_symbol_value_print (FILE *yyoutput, int yytype, YYSTYPE const * const yyvaluep, YYLTYPE const * const yylocationp)
+yy_symbol_value_print (FILE *yyo,
+                       yysymbol_kind_t yykind, YYSTYPE const * const yyvaluep, YYLTYPE const * const yylocationp, io::LibertyContext& ctx)
 {
-  FILE *yyo = yyoutput;
-  YYUSE (yyo);
-  YYUSE (yylocationp);
+  FILE *yyoutput = yyo;
+  YY_USE (yyoutput);
+  YY_USE (yylocationp);
+  YY_USE (ctx);
   if (!yyvaluep)
     return;
-# ifdef YYPRINT
-  if (yytype < YYNTOKENS)
-    YYPRINT (yyoutput, yytoknum[yytype], *yyvaluep);
-# endif
-  YYUSE (yytype);
+  YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+  YY_USE (yykind);
+  YY_IGNORE_MAYBE_UNINITIALIZED_END
 }
 
 
-/*--------------------------------.
-| Print this symbol on YYOUTPUT.  |
-`--------------------------------*/
+/*---------------------------.
+| Print this symbol on YYO.  |
+`---------------------------*/
 
 static void
-yy_symbol_print (FILE *yyoutput, int yytype, YYSTYPE const * const yyvaluep, YYLTYPE const * const yylocationp)
+yy_symbol_print (FILE *yyo,
+                 yysymbol_kind_t yykind, YYSTYPE const * const yyvaluep, YYLTYPE const * const yylocationp, io::LibertyContext& ctx)
 {
-  YYFPRINTF (yyoutput, "%s %s (",
-             yytype < YYNTOKENS ? "token" : "nterm", yytname[yytype]);
+  YYFPRINTF (yyo, "%s %s (",
+             yykind < YYNTOKENS ? "token" : "nterm", yysymbol_name (yykind));
 
-  YY_LOCATION_PRINT (yyoutput, *yylocationp);
-  YYFPRINTF (yyoutput, ": ");
-  yy_symbol_value_print (yyoutput, yytype, yyvaluep, yylocationp);
-  YYFPRINTF (yyoutput, ")");
+  YYLOCATION_PRINT (yyo, yylocationp);
+  YYFPRINTF (yyo, ": ");
+  yy_symbol_value_print (yyo, yykind, yyvaluep, yylocationp, ctx);
+  YYFPRINTF (yyo, ")");
 }
 
 /*------------------------------------------------------------------.
@@ -761,7 +824,7 @@ yy_symbol_print (FILE *yyoutput, int yytype, YYSTYPE const * const yyvaluep, YYL
 `------------------------------------------------------------------*/
 
 static void
-yy_stack_print (yytype_int16 *yybottom, yytype_int16 *yytop)
+yy_stack_print (yy_state_t *yybottom, yy_state_t *yytop)
 {
   YYFPRINTF (stderr, "Stack now");
   for (; yybottom <= yytop; yybottom++)
@@ -784,21 +847,22 @@ do {                                                            \
 `------------------------------------------------*/
 
 static void
-yy_reduce_print (yytype_int16 *yyssp, YYSTYPE *yyvsp, YYLTYPE *yylsp, int yyrule)
+yy_reduce_print (yy_state_t *yyssp, YYSTYPE *yyvsp, YYLTYPE *yylsp,
+                 int yyrule, io::LibertyContext& ctx)
 {
-  unsigned long yylno = yyrline[yyrule];
+  int yylno = yyrline[yyrule];
   int yynrhs = yyr2[yyrule];
   int yyi;
-  YYFPRINTF (stderr, "Reducing stack by rule %d (line %lu):\n",
+  YYFPRINTF (stderr, "Reducing stack by rule %d (line %d):\n",
              yyrule - 1, yylno);
   /* The symbols being reduced.  */
   for (yyi = 0; yyi < yynrhs; yyi++)
     {
       YYFPRINTF (stderr, "   $%d = ", yyi + 1);
       yy_symbol_print (stderr,
-                       yystos[yyssp[yyi + 1 - yynrhs]],
-                       &(yyvsp[(yyi + 1) - (yynrhs)])
-                       , &(yylsp[(yyi + 1) - (yynrhs)])                       );
+                       YY_ACCESSING_SYMBOL (+yyssp[yyi + 1 - yynrhs]),
+                       &yyvsp[(yyi + 1) - (yynrhs)],
+                       &(yylsp[(yyi + 1) - (yynrhs)]), ctx);
       YYFPRINTF (stderr, "\n");
     }
 }
@@ -806,15 +870,15 @@ yy_reduce_print (yytype_int16 *yyssp, YYSTYPE *yyvsp, YYLTYPE *yylsp, int yyrule
 # define YY_REDUCE_PRINT(Rule)          \
 do {                                    \
   if (yydebug)                          \
-    yy_reduce_print (yyssp, yyvsp, yylsp, Rule); \
+    yy_reduce_print (yyssp, yyvsp, yylsp, Rule, ctx); \
 } while (0)
 
 /* Nonzero means print parse trace.  It is left uninitialized so that
    multiple parsers can coexist.  */
 int yydebug;
 #else /* !YYDEBUG */
-# define YYDPRINTF(Args)
-# define YY_SYMBOL_PRINT(Title, Type, Value, Location)
+# define YYDPRINTF(Args) ((void) 0)
+# define YY_SYMBOL_PRINT(Title, Kind, Value, Location)
 # define YY_STACK_PRINT(Bottom, Top)
 # define YY_REDUCE_PRINT(Rule)
 #endif /* !YYDEBUG */
@@ -836,6 +900,7 @@ int yydebug;
 # define YYMAXDEPTH 10000
 #endif
 
+
 /* Given a state stack such that *YYBOTTOM is its bottom, such that
    *YYTOP is either its top or is YYTOP_EMPTY to indicate an empty
    stack, and such that *YYCAPACITY is the maximum number of elements it
@@ -845,24 +910,24 @@ int yydebug;
    *YYTOP, and *YYCAPACITY to reflect the new capacity and memory
    location.  If *YYBOTTOM != YYBOTTOM_NO_FREE, then free the old stack
    using YYSTACK_FREE.  Return 0 if successful or if no reallocation is
-   required.  Return 1 if memory is exhausted.  */
+   required.  Return YYENOMEM if memory is exhausted.  */
 static int
-yy_lac_stack_realloc (YYSIZE_T *yycapacity, YYSIZE_T yyadd,
+yy_lac_stack_realloc (YYPTRDIFF_T *yycapacity, YYPTRDIFF_T yyadd,
 #if YYDEBUG
                       char const *yydebug_prefix,
                       char const *yydebug_suffix,
 #endif
-                      yytype_int16 **yybottom,
-                      yytype_int16 *yybottom_no_free,
-                      yytype_int16 **yytop, yytype_int16 *yytop_empty)
+                      yy_state_t **yybottom,
+                      yy_state_t *yybottom_no_free,
+                      yy_state_t **yytop, yy_state_t *yytop_empty)
 {
-  YYSIZE_T yysize_old =
+  YYPTRDIFF_T yysize_old =
     *yytop == yytop_empty ? 0 : *yytop - *yybottom + 1;
-  YYSIZE_T yysize_new = yysize_old + yyadd;
+  YYPTRDIFF_T yysize_new = yysize_old + yyadd;
   if (*yycapacity < yysize_new)
     {
-      YYSIZE_T yyalloc = 2 * yysize_new;
-      yytype_int16 *yybottom_new;
+      YYPTRDIFF_T yyalloc = 2 * yysize_new;
+      yy_state_t *yybottom_new;
       /* Use YYMAXDEPTH for maximum stack size given that the stack
          should never need to grow larger than the main state stack
          needs to grow without LAC.  */
@@ -870,17 +935,19 @@ yy_lac_stack_realloc (YYSIZE_T *yycapacity, YYSIZE_T yyadd,
         {
           YYDPRINTF ((stderr, "%smax size exceeded%s", yydebug_prefix,
                       yydebug_suffix));
-          return 1;
+          return YYENOMEM;
         }
       if (YYMAXDEPTH < yyalloc)
         yyalloc = YYMAXDEPTH;
       yybottom_new =
-        (yytype_int16*) YYSTACK_ALLOC (yyalloc * sizeof *yybottom_new);
+        YY_CAST (yy_state_t *,
+                 YYSTACK_ALLOC (YY_CAST (YYSIZE_T,
+                                         yyalloc * YYSIZEOF (*yybottom_new))));
       if (!yybottom_new)
         {
           YYDPRINTF ((stderr, "%srealloc failed%s", yydebug_prefix,
                       yydebug_suffix));
-          return 1;
+          return YYENOMEM;
         }
       if (*yytop != yytop_empty)
         {
@@ -921,23 +988,22 @@ yy_lac_stack_realloc (YYSIZE_T *yycapacity, YYSIZE_T yyadd,
    current lookahead, then check if that lookahead can eventually be
    shifted if syntactic actions continue from the current context.
    Report a syntax error if it cannot.  */
-#define YY_LAC_ESTABLISH                                         \
-do {                                                             \
-  if (!yy_lac_established)                                       \
-    {                                                            \
-      YYDPRINTF ((stderr,                                        \
-                  "LAC: initial context established for %s\n",   \
-                  yytname[yytoken]));                            \
-      yy_lac_established = 1;                                    \
-      {                                                          \
-        int yy_lac_status =                                      \
-          yy_lac (yyesa, &yyes, &yyes_capacity, yyssp, yytoken); \
-        if (yy_lac_status == 2)                                  \
-          goto yyexhaustedlab;                                   \
-        if (yy_lac_status == 1)                                  \
-          goto yyerrlab;                                         \
-      }                                                          \
-    }                                                            \
+#define YY_LAC_ESTABLISH                                                \
+do {                                                                    \
+  if (!yy_lac_established)                                              \
+    {                                                                   \
+      YYDPRINTF ((stderr,                                               \
+                  "LAC: initial context established for %s\n",          \
+                  yysymbol_name (yytoken)));                            \
+      yy_lac_established = 1;                                           \
+      switch (yy_lac (yyesa, &yyes, &yyes_capacity, yyssp, yytoken))    \
+        {                                                               \
+        case YYENOMEM:                                                  \
+          YYNOMEM;                                                      \
+        case 1:                                                         \
+          goto yyerrlab;                                                \
+        }                                                               \
+    }                                                                   \
 } while (0)
 
 /* Discard any previous initial lookahead context because of Event,
@@ -956,9 +1022,8 @@ do {                                                             \
 do {                                                                     \
   if (yy_lac_established)                                                \
     {                                                                    \
-      if (yydebug)                                                       \
-        YYFPRINTF (stderr, "LAC: initial context discarded due to "      \
-                   Event "\n");                                          \
+      YYDPRINTF ((stderr, "LAC: initial context discarded due to "       \
+                  Event "\n"));                                          \
       yy_lac_established = 0;                                            \
     }                                                                    \
 } while (0)
@@ -968,32 +1033,34 @@ do {                                                                     \
 
 /* Given the stack whose top is *YYSSP, return 0 iff YYTOKEN can
    eventually (after perhaps some reductions) be shifted, return 1 if
-   not, or return 2 if memory is exhausted.  As preconditions and
+   not, or return YYENOMEM if memory is exhausted.  As preconditions and
    postconditions: *YYES_CAPACITY is the allocated size of the array to
    which *YYES points, and either *YYES = YYESA or *YYES points to an
    array allocated with YYSTACK_ALLOC.  yy_lac may overwrite the
    contents of either array, alter *YYES and *YYES_CAPACITY, and free
    any old *YYES other than YYESA.  */
 static int
-yy_lac (yytype_int16 *yyesa, yytype_int16 **yyes,
-        YYSIZE_T *yyes_capacity, yytype_int16 *yyssp, int yytoken)
+yy_lac (yy_state_t *yyesa, yy_state_t **yyes,
+        YYPTRDIFF_T *yyes_capacity, yy_state_t *yyssp, yysymbol_kind_t yytoken)
 {
-  yytype_int16 *yyes_prev = yyssp;
-  yytype_int16 *yyesp = yyes_prev;
-  YYDPRINTF ((stderr, "LAC: checking lookahead %s:", yytname[yytoken]));
-  if (yytoken == YYUNDEFTOK)
+  yy_state_t *yyes_prev = yyssp;
+  yy_state_t *yyesp = yyes_prev;
+  /* Reduce until we encounter a shift and thereby accept the token.  */
+  YYDPRINTF ((stderr, "LAC: checking lookahead %s:", yysymbol_name (yytoken)));
+  if (yytoken == YYSYMBOL_YYUNDEF)
     {
       YYDPRINTF ((stderr, " Always Err\n"));
       return 1;
     }
   while (1)
     {
-      int yyrule = yypact[*yyesp];
+      int yyrule = yypact[+*yyesp];
       if (yypact_value_is_default (yyrule)
           || (yyrule += yytoken) < 0 || YYLAST < yyrule
           || yycheck[yyrule] != yytoken)
         {
-          yyrule = yydefact[*yyesp];
+          /* Use the default action.  */
+          yyrule = yydefact[+*yyesp];
           if (yyrule == 0)
             {
               YYDPRINTF ((stderr, " Err\n"));
@@ -1002,6 +1069,7 @@ yy_lac (yytype_int16 *yyesa, yytype_int16 **yyes,
         }
       else
         {
+          /* Use the action from yytable.  */
           yyrule = yytable[yyrule];
           if (yytable_value_is_error (yyrule))
             {
@@ -1015,12 +1083,15 @@ yy_lac (yytype_int16 *yyesa, yytype_int16 **yyes,
             }
           yyrule = -yyrule;
         }
+      /* By now we know we have to simulate a reduce.  */
+      YYDPRINTF ((stderr, " R%d", yyrule - 1));
       {
-        YYSIZE_T yylen = yyr2[yyrule];
-        YYDPRINTF ((stderr, " R%d", yyrule - 1));
+        /* Pop the corresponding number of values from the stack.  */
+        YYPTRDIFF_T yylen = yyr2[yyrule];
+        /* First pop from the LAC stack as many tokens as possible.  */
         if (yyesp != yyes_prev)
           {
-            YYSIZE_T yysize = yyesp - *yyes + 1;
+            YYPTRDIFF_T yysize = yyesp - *yyes + 1;
             if (yylen < yysize)
               {
                 yyesp -= yylen;
@@ -1028,28 +1099,30 @@ yy_lac (yytype_int16 *yyesa, yytype_int16 **yyes,
               }
             else
               {
-                yylen -= yysize;
                 yyesp = yyes_prev;
+                yylen -= yysize;
               }
           }
+        /* Only afterwards look at the main stack.  */
         if (yylen)
           yyesp = yyes_prev -= yylen;
       }
+      /* Push the resulting state of the reduction.  */
       {
-        int yystate;
+        yy_state_fast_t yystate;
         {
-          int yylhs = yyr1[yyrule] - YYNTOKENS;
-          yystate = yypgoto[yylhs] + *yyesp;
-          if (yystate < 0 || YYLAST < yystate
-              || yycheck[yystate] != *yyesp)
-            yystate = yydefgoto[yylhs];
-          else
-            yystate = yytable[yystate];
+          const int yylhs = yyr1[yyrule] - YYNTOKENS;
+          const int yyi = yypgoto[yylhs] + *yyesp;
+          yystate = (0 <= yyi && yyi <= YYLAST && yycheck[yyi] == *yyesp
+                     ? yytable[yyi]
+                     : yydefgoto[yylhs]);
         }
         if (yyesp == yyes_prev)
           {
             yyesp = *yyes;
-            *yyesp = yystate;
+            YY_IGNORE_USELESS_CAST_BEGIN
+            *yyesp = YY_CAST (yy_state_t, yystate);
+            YY_IGNORE_USELESS_CAST_END
           }
         else
           {
@@ -1060,38 +1133,89 @@ yy_lac (yytype_int16 *yyesa, yytype_int16 **yyes,
                                       yyes, yyesa, &yyesp, yyes_prev))
               {
                 YYDPRINTF ((stderr, "\n"));
-                return 2;
+                return YYENOMEM;
               }
-            *++yyesp = yystate;
+            YY_IGNORE_USELESS_CAST_BEGIN
+            *++yyesp = YY_CAST (yy_state_t, yystate);
+            YY_IGNORE_USELESS_CAST_END
           }
         YYDPRINTF ((stderr, " G%d", yystate));
       }
     }
 }
 
+/* Context of a parse error.  */
+typedef struct
+{
+  yy_state_t *yyssp;
+  yy_state_t *yyesa;
+  yy_state_t **yyes;
+  YYPTRDIFF_T *yyes_capacity;
+  yysymbol_kind_t yytoken;
+  YYLTYPE *yylloc;
+} yypcontext_t;
+
+/* Put in YYARG at most YYARGN of the expected tokens given the
+   current YYCTX, and return the number of tokens stored in YYARG.  If
+   YYARG is null, return the number of expected tokens (guaranteed to
+   be less than YYNTOKENS).  Return YYENOMEM on memory exhaustion.
+   Return 0 if there are more than YYARGN expected tokens, yet fill
+   YYARG up to YYARGN. */
+static int
+yypcontext_expected_tokens (const yypcontext_t *yyctx,
+                            yysymbol_kind_t yyarg[], int yyargn)
+{
+  /* Actual size of YYARG. */
+  int yycount = 0;
 
-#if YYERROR_VERBOSE
+  int yyx;
+  for (yyx = 0; yyx < YYNTOKENS; ++yyx)
+    {
+      yysymbol_kind_t yysym = YY_CAST (yysymbol_kind_t, yyx);
+      if (yysym != YYSYMBOL_YYerror && yysym != YYSYMBOL_YYUNDEF)
+        switch (yy_lac (yyctx->yyesa, yyctx->yyes, yyctx->yyes_capacity, yyctx->yyssp, yysym))
+          {
+          case YYENOMEM:
+            return YYENOMEM;
+          case 1:
+            continue;
+          default:
+            if (!yyarg)
+              ++yycount;
+            else if (yycount == yyargn)
+              return 0;
+            else
+              yyarg[yycount++] = yysym;
+          }
+    }
+  if (yyarg && yycount == 0 && 0 < yyargn)
+    yyarg[0] = YYSYMBOL_YYEMPTY;
+  return yycount;
+}
 
-# ifndef yystrlen
-#  if defined __GLIBC__ && defined _STRING_H
-#   define yystrlen strlen
-#  else
+
+
+
+#ifndef yystrlen
+# if defined __GLIBC__ && defined _STRING_H
+#  define yystrlen(S) (YY_CAST (YYPTRDIFF_T, strlen (S)))
+# else
 /* Return the length of YYSTR.  */
-static YYSIZE_T
+static YYPTRDIFF_T
 yystrlen (const char *yystr)
 {
-  YYSIZE_T yylen;
+  YYPTRDIFF_T yylen;
   for (yylen = 0; yystr[yylen]; yylen++)
     continue;
   return yylen;
 }
-#  endif
 # endif
+#endif
 
-# ifndef yystpcpy
-#  if defined __GLIBC__ && defined _STRING_H && defined _GNU_SOURCE
-#   define yystpcpy stpcpy
-#  else
+#ifndef yystpcpy
+# if defined __GLIBC__ && defined _STRING_H && defined _GNU_SOURCE
+#  define yystpcpy stpcpy
+# else
 /* Copy YYSRC to YYDEST, returning the address of the terminating '\0' in
    YYDEST.  */
 static char *
@@ -1105,10 +1229,10 @@ yystpcpy (char *yydest, const char *yysrc)
 
   return yyd - 1;
 }
-#  endif
 # endif
+#endif
 
-# ifndef yytnamerr
+#ifndef yytnamerr
 /* Copy to YYRES the contents of YYSTR after stripping away unnecessary
    quotes and backslashes, so that it's suitable for yyerror.  The
    heuristic is that double-quoting is unnecessary unless the string
@@ -1116,14 +1240,13 @@ yystpcpy (char *yydest, const char *yysrc)
    backslash-backslash).  YYSTR is taken from yytname.  If YYRES is
    null, do not copy; instead, return the length of what the result
    would have been.  */
-static YYSIZE_T
+static YYPTRDIFF_T
 yytnamerr (char *yyres, const char *yystr)
 {
   if (*yystr == '"')
     {
-      YYSIZE_T yyn = 0;
+      YYPTRDIFF_T yyn = 0;
       char const *yyp = yystr;
-
       for (;;)
         switch (*++yyp)
           {
@@ -1134,7 +1257,10 @@ yytnamerr (char *yyres, const char *yystr)
           case '\\':
             if (*++yyp != '\\')
               goto do_not_strip_quotes;
-            /* Fall through.  */
+            else
+              goto append;
+
+          append:
           default:
             if (yyres)
               yyres[yyn] = *yyp;
@@ -1149,39 +1275,20 @@ yytnamerr (char *yyres, const char *yystr)
     do_not_strip_quotes: ;
     }
 
-  if (! yyres)
+  if (yyres)
+    return yystpcpy (yyres, yystr) - yyres;
+  else
     return yystrlen (yystr);
-
-  return yystpcpy (yyres, yystr) - yyres;
 }
-# endif
+#endif
 
-/* Copy into *YYMSG, which is of size *YYMSG_ALLOC, an error message
-   about the unexpected token YYTOKEN for the state stack whose top is
-   YYSSP.  In order to see if a particular token T is a
-   valid looakhead, invoke yy_lac (YYESA, YYES, YYES_CAPACITY, YYSSP, T).
 
-   Return 0 if *YYMSG was successfully written.  Return 1 if *YYMSG is
-   not large enough to hold the message.  In that case, also set
-   *YYMSG_ALLOC to the required number of bytes.  Return 2 if the
-   required number of bytes is too large to store or if
-   yy_lac returned 2.  */
 static int
-yysyntax_error (YYSIZE_T *yymsg_alloc, char **yymsg,
-                yytype_int16 *yyesa, yytype_int16 **yyes,
-                YYSIZE_T *yyes_capacity, yytype_int16 *yyssp, int yytoken)
+yy_syntax_error_arguments (const yypcontext_t *yyctx,
+                           yysymbol_kind_t yyarg[], int yyargn)
 {
-  YYSIZE_T yysize0 = yytnamerr (YY_NULLPTR, yytname[yytoken]);
-  YYSIZE_T yysize = yysize0;
-  enum { YYERROR_VERBOSE_ARGS_MAXIMUM = 5 };
-  /* Internationalized format string. */
-  const char *yyformat = YY_NULLPTR;
-  /* Arguments of yyformat. */
-  char const *yyarg[YYERROR_VERBOSE_ARGS_MAXIMUM];
-  /* Number of reported tokens (one for the "unexpected", one per
-     "expected"). */
+  /* Actual size of YYARG. */
   int yycount = 0;
-
   /* There are many possibilities here to consider:
      - If this state is a consistent state with a default action, then
        the only way this function was invoked is if the default action
@@ -1202,54 +1309,59 @@ yysyntax_error (YYSIZE_T *yymsg_alloc, char **yymsg,
        different syntax error that discarded a different initial context
        during error recovery, leaving behind the current lookahead.
   */
-  if (yytoken != YYEMPTY)
+  if (yyctx->yytoken != YYSYMBOL_YYEMPTY)
     {
-      int yyn = yypact[*yyssp];
+      int yyn;
       YYDPRINTF ((stderr, "Constructing syntax error message\n"));
-      yyarg[yycount++] = yytname[yytoken];
-      if (!yypact_value_is_default (yyn))
-        {
-          int yyx;
-
-          for (yyx = 0; yyx < YYNTOKENS; ++yyx)
-            if (yyx != YYTERROR && yyx != YYUNDEFTOK)
-              {
-                {
-                  int yy_lac_status = yy_lac (yyesa, yyes, yyes_capacity,
-                                              yyssp, yyx);
-                  if (yy_lac_status == 2)
-                    return 2;
-                  if (yy_lac_status == 1)
-                    continue;
-                }
-                if (yycount == YYERROR_VERBOSE_ARGS_MAXIMUM)
-                  {
-                    yycount = 1;
-                    yysize = yysize0;
-                    break;
-                  }
-                yyarg[yycount++] = yytname[yyx];
-                {
-                  YYSIZE_T yysize1 = yysize + yytnamerr (YY_NULLPTR, yytname[yyx]);
-                  if (! (yysize <= yysize1
-                         && yysize1 <= YYSTACK_ALLOC_MAXIMUM))
-                    return 2;
-                  yysize = yysize1;
-                }
-              }
-        }
-# if YYDEBUG
-      else if (yydebug)
-        YYFPRINTF (stderr, "No expected tokens.\n");
-# endif
+      if (yyarg)
+        yyarg[yycount] = yyctx->yytoken;
+      ++yycount;
+      yyn = yypcontext_expected_tokens (yyctx,
+                                        yyarg ? yyarg + 1 : yyarg, yyargn - 1);
+      if (yyn == YYENOMEM)
+        return YYENOMEM;
+      else if (yyn == 0)
+        YYDPRINTF ((stderr, "No expected tokens.\n"));
+      else
+        yycount += yyn;
     }
+  return yycount;
+}
+
+/* Copy into *YYMSG, which is of size *YYMSG_ALLOC, an error message
+   about the unexpected token YYTOKEN for the state stack whose top is
+   YYSSP.  In order to see if a particular token T is a
+   valid looakhead, invoke yy_lac (YYESA, YYES, YYES_CAPACITY, YYSSP, T).
+
+   Return 0 if *YYMSG was successfully written.  Return -1 if *YYMSG is
+   not large enough to hold the message.  In that case, also set
+   *YYMSG_ALLOC to the required number of bytes.  Return YYENOMEM if the
+   required number of bytes is too large to store or if
+   yy_lac returned YYENOMEM.  */
+static int
+yysyntax_error (YYPTRDIFF_T *yymsg_alloc, char **yymsg,
+                const yypcontext_t *yyctx)
+{
+  enum { YYARGS_MAX = 5 };
+  /* Internationalized format string. */
+  const char *yyformat = YY_NULLPTR;
+  /* Arguments of yyformat: reported tokens (one for the "unexpected",
+     one per "expected"). */
+  yysymbol_kind_t yyarg[YYARGS_MAX];
+  /* Cumulated lengths of YYARG.  */
+  YYPTRDIFF_T yysize = 0;
+
+  /* Actual size of YYARG. */
+  int yycount = yy_syntax_error_arguments (yyctx, yyarg, YYARGS_MAX);
+  if (yycount == YYENOMEM)
+    return YYENOMEM;
 
   switch (yycount)
     {
-# define YYCASE_(N, S)                      \
+#define YYCASE_(N, S)                       \
       case N:                               \
         yyformat = S;                       \
-      break
+        break
     default: /* Avoid compiler warnings. */
       YYCASE_(0, YY_("syntax error"));
       YYCASE_(1, YY_("syntax error, unexpected %s"));
@@ -1257,14 +1369,23 @@ yysyntax_error (YYSIZE_T *yymsg_alloc, char **yymsg,
       YYCASE_(3, YY_("syntax error, unexpected %s, expecting %s or %s"));
       YYCASE_(4, YY_("syntax error, unexpected %s, expecting %s or %s or %s"));
       YYCASE_(5, YY_("syntax error, unexpected %s, expecting %s or %s or %s or %s"));
-# undef YYCASE_
+#undef YYCASE_
     }
 
+  /* Compute error message size.  Don't count the "%s"s, but reserve
+     room for the terminator.  */
+  yysize = yystrlen (yyformat) - 2 * yycount + 1;
   {
-    YYSIZE_T yysize1 = yysize + yystrlen (yyformat);
-    if (! (yysize <= yysize1 && yysize1 <= YYSTACK_ALLOC_MAXIMUM))
-      return 2;
-    yysize = yysize1;
+    int yyi;
+    for (yyi = 0; yyi < yycount; ++yyi)
+      {
+        YYPTRDIFF_T yysize1
+          = yysize + yytnamerr (YY_NULLPTR, yytname[yyarg[yyi]]);
+        if (yysize <= yysize1 && yysize1 <= YYSTACK_ALLOC_MAXIMUM)
+          yysize = yysize1;
+        else
+          return YYENOMEM;
+      }
   }
 
   if (*yymsg_alloc < yysize)
@@ -1273,7 +1394,7 @@ yysyntax_error (YYSIZE_T *yymsg_alloc, char **yymsg,
       if (! (yysize <= *yymsg_alloc
              && *yymsg_alloc <= YYSTACK_ALLOC_MAXIMUM))
         *yymsg_alloc = YYSTACK_ALLOC_MAXIMUM;
-      return 1;
+      return -1;
     }
 
   /* Avoid sprintf, as that infringes on the user's name space.
@@ -1285,114 +1406,120 @@ yysyntax_error (YYSIZE_T *yymsg_alloc, char **yymsg,
     while ((*yyp = *yyformat) != '\0')
       if (*yyp == '%' && yyformat[1] == 's' && yyi < yycount)
         {
-          yyp += yytnamerr (yyp, yyarg[yyi++]);
+          yyp += yytnamerr (yyp, yytname[yyarg[yyi++]]);
           yyformat += 2;
         }
       else
         {
-          yyp++;
-          yyformat++;
+          ++yyp;
+          ++yyformat;
         }
   }
   return 0;
 }
-#endif /* YYERROR_VERBOSE */
+
 
 /*-----------------------------------------------.
 | Release the memory associated to this symbol.  |
 `-----------------------------------------------*/
 
 static void
-yydestruct (const char *yymsg, int yytype, YYSTYPE *yyvaluep, YYLTYPE *yylocationp)
+yydestruct (const char *yymsg,
+            yysymbol_kind_t yykind, YYSTYPE *yyvaluep, YYLTYPE *yylocationp, io::LibertyContext& ctx)
 {
-  YYUSE (yyvaluep);
-  YYUSE (yylocationp);
+  YY_USE (yyvaluep);
+  YY_USE (yylocationp);
+  YY_USE (ctx);
   if (!yymsg)
     yymsg = "Deleting";
-  YY_SYMBOL_PRINT (yymsg, yytype, yyvaluep, yylocationp);
+  YY_SYMBOL_PRINT (yymsg, yykind, yyvaluep, yylocationp);
 
   YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
-  YYUSE (yytype);
+  YY_USE (yykind);
   YY_IGNORE_MAYBE_UNINITIALIZED_END
 }
 
 
 
 
-/* The lookahead symbol.  */
+
+
+/*----------.
+| yyparse.  |
+`----------*/
+
+int
+yyparse (io::LibertyContext& ctx)
+{
+/* Lookahead token kind.  */
 int yychar;
 
+
 /* The semantic value of the lookahead symbol.  */
-YYSTYPE yylval;
+/* Default value used for initialization, for pacifying older GCCs
+   or non-GCC compilers.  */
+YY_INITIAL_VALUE (static YYSTYPE yyval_default;)
+YYSTYPE yylval YY_INITIAL_VALUE (= yyval_default);
+
 /* Location data for the lookahead symbol.  */
-YYLTYPE yylloc
+static YYLTYPE yyloc_default
 # if defined YYLTYPE_IS_TRIVIAL && YYLTYPE_IS_TRIVIAL
   = { 1, 1, 1, 1 }
 # endif
 ;
-/* Number of syntax errors so far.  */
-int yynerrs;
-
+YYLTYPE yylloc = yyloc_default;
 
-/*----------.
-| yyparse.  |
-`----------*/
+    /* Number of syntax errors so far.  */
+    int yynerrs = 0;
 
-int
-yyparse (void)
-{
-    int yystate;
+    yy_state_fast_t yystate = 0;
     /* Number of tokens to shift before error messages enabled.  */
-    int yyerrstatus;
-
-    /* The stacks and their tools:
-       'yyss': related to states.
-       'yyvs': related to semantic values.
-       'yyls': related to locations.
+    int yyerrstatus = 0;
 
-       Refer to the stacks through separate pointers, to allow yyoverflow
+    /* Refer to the stacks through separate pointers, to allow yyoverflow
        to reallocate them elsewhere.  */
 
-    /* The state stack.  */
-    yytype_int16 yyssa[YYINITDEPTH];
-    yytype_int16 *yyss;
-    yytype_int16 *yyssp;
+    /* Their size.  */
+    YYPTRDIFF_T yystacksize = YYINITDEPTH;
+
+    /* The state stack: array, bottom, top.  */
+    yy_state_t yyssa[YYINITDEPTH];
+    yy_state_t *yyss = yyssa;
+    yy_state_t *yyssp = yyss;
 
-    /* The semantic value stack.  */
+    /* The semantic value stack: array, bottom, top.  */
     YYSTYPE yyvsa[YYINITDEPTH];
-    YYSTYPE *yyvs;
-    YYSTYPE *yyvsp;
+    YYSTYPE *yyvs = yyvsa;
+    YYSTYPE *yyvsp = yyvs;
 
-    /* The location stack.  */
+    /* The location stack: array, bottom, top.  */
     YYLTYPE yylsa[YYINITDEPTH];
-    YYLTYPE *yyls;
-    YYLTYPE *yylsp;
-
-    /* The locations where the error started and ended.  */
-    YYLTYPE yyerror_range[3];
-
-    YYSIZE_T yystacksize;
+    YYLTYPE *yyls = yylsa;
+    YYLTYPE *yylsp = yyls;
 
-    yytype_int16 yyesa[20];
-    yytype_int16 *yyes;
-    YYSIZE_T yyes_capacity;
+    yy_state_t yyesa[20];
+    yy_state_t *yyes = yyesa;
+    YYPTRDIFF_T yyes_capacity = 20 < YYMAXDEPTH ? 20 : YYMAXDEPTH;
 
+  /* Whether LAC context is established.  A Boolean.  */
   int yy_lac_established = 0;
   int yyn;
+  /* The return value of yyparse.  */
   int yyresult;
-  /* Lookahead token as an internal (translated) token number.  */
-  int yytoken = 0;
+  /* Lookahead symbol kind.  */
+  yysymbol_kind_t yytoken = YYSYMBOL_YYEMPTY;
   /* The variables used to return semantic value and location from the
      action routines.  */
   YYSTYPE yyval;
   YYLTYPE yyloc;
 
-#if YYERROR_VERBOSE
+  /* The locations where the error started and ended.  */
+  YYLTYPE yyerror_range[3];
+
   /* Buffer for error messages, and its allocated size.  */
   char yymsgbuf[128];
   char *yymsg = yymsgbuf;
-  YYSIZE_T yymsg_alloc = sizeof yymsgbuf;
-#endif
+  YYPTRDIFF_T yymsg_alloc = sizeof yymsgbuf;
 
 #define YYPOPSTACK(N)   (yyvsp -= (N), yyssp -= (N), yylsp -= (N))
 
@@ -1400,48 +1527,49 @@ yyparse (void)
      Keep to zero when no symbol should be popped.  */
   int yylen = 0;
 
-  yyssp = yyss = yyssa;
-  yyvsp = yyvs = yyvsa;
-  yylsp = yyls = yylsa;
-  yystacksize = YYINITDEPTH;
-
-  yyes = yyesa;
-  yyes_capacity = sizeof yyesa / sizeof *yyes;
-  if (YYMAXDEPTH < yyes_capacity)
-    yyes_capacity = YYMAXDEPTH;
-
   YYDPRINTF ((stderr, "Starting parse\n"));
 
-  yystate = 0;
-  yyerrstatus = 0;
-  yynerrs = 0;
   yychar = YYEMPTY; /* Cause a token to be read.  */
+
   yylsp[0] = yylloc;
   goto yysetstate;
 
+
 /*------------------------------------------------------------.
-| yynewstate -- Push a new state, which is found in yystate.  |
+| yynewstate -- push a new state, which is found in yystate.  |
 `------------------------------------------------------------*/
- yynewstate:
+yynewstate:
   /* In all cases, when you get here, the value and location stacks
      have just been pushed.  So pushing a state here evens the stacks.  */
   yyssp++;
 
- yysetstate:
-  *yyssp = yystate;
+
+/*--------------------------------------------------------------------.
+| yysetstate -- set current state (the top of the stack) to yystate.  |
+`--------------------------------------------------------------------*/
+yysetstate:
+  YYDPRINTF ((stderr, "Entering state %d\n", yystate));
+  YY_ASSERT (0 <= yystate && yystate < YYNSTATES);
+  YY_IGNORE_USELESS_CAST_BEGIN
+  *yyssp = YY_CAST (yy_state_t, yystate);
+  YY_IGNORE_USELESS_CAST_END
+  YY_STACK_PRINT (yyss, yyssp);
 
   if (yyss + yystacksize - 1 <= yyssp)
+#if !defined yyoverflow && !defined YYSTACK_RELOCATE
+    YYNOMEM;
+#else
     {
       /* Get the current used size of the three stacks, in elements.  */
-      YYSIZE_T yysize = yyssp - yyss + 1;
+      YYPTRDIFF_T yysize = yyssp - yyss + 1;
 
-#ifdef yyoverflow
+# if defined yyoverflow
       {
         /* Give user a chance to reallocate the stack.  Use copies of
            these so that the &'s don't force the real ones into
            memory.  */
+        yy_state_t *yyss1 = yyss;
         YYSTYPE *yyvs1 = yyvs;
-        yytype_int16 *yyss1 = yyss;
         YYLTYPE *yyls1 = yyls;
 
         /* Each stack pointer address is followed by the size of the
@@ -1449,32 +1577,29 @@ yyparse (void)
            conditional around just the two extra args, but that might
            be undefined if yyoverflow is a macro.  */
         yyoverflow (YY_("memory exhausted"),
-                    &yyss1, yysize * sizeof (*yyssp),
-                    &yyvs1, yysize * sizeof (*yyvsp),
-                    &yyls1, yysize * sizeof (*yylsp),
+                    &yyss1, yysize * YYSIZEOF (*yyssp),
+                    &yyvs1, yysize * YYSIZEOF (*yyvsp),
+                    &yyls1, yysize * YYSIZEOF (*yylsp),
                     &yystacksize);
-
-        yyls = yyls1;
         yyss = yyss1;
         yyvs = yyvs1;
+        yyls = yyls1;
       }
-#else /* no yyoverflow */
-# ifndef YYSTACK_RELOCATE
-      goto yyexhaustedlab;
-# else
+# else /* defined YYSTACK_RELOCATE */
       /* Extend the stack our own way.  */
       if (YYMAXDEPTH <= yystacksize)
-        goto yyexhaustedlab;
+        YYNOMEM;
       yystacksize *= 2;
       if (YYMAXDEPTH < yystacksize)
         yystacksize = YYMAXDEPTH;
 
       {
-        yytype_int16 *yyss1 = yyss;
+        yy_state_t *yyss1 = yyss;
         union yyalloc *yyptr =
-          (union yyalloc *) YYSTACK_ALLOC (YYSTACK_BYTES (yystacksize));
+          YY_CAST (union yyalloc *,
+                   YYSTACK_ALLOC (YY_CAST (YYSIZE_T, YYSTACK_BYTES (yystacksize))));
         if (! yyptr)
-          goto yyexhaustedlab;
+          YYNOMEM;
         YYSTACK_RELOCATE (yyss_alloc, yyss);
         YYSTACK_RELOCATE (yyvs_alloc, yyvs);
         YYSTACK_RELOCATE (yyls_alloc, yyls);
@@ -1483,31 +1608,32 @@ yyparse (void)
           YYSTACK_FREE (yyss1);
       }
 # endif
-#endif /* no yyoverflow */
 
       yyssp = yyss + yysize - 1;
       yyvsp = yyvs + yysize - 1;
       yylsp = yyls + yysize - 1;
 
-      YYDPRINTF ((stderr, "Stack size increased to %lu\n",
-                  (unsigned long) yystacksize));
+      YY_IGNORE_USELESS_CAST_BEGIN
+      YYDPRINTF ((stderr, "Stack size increased to %ld\n",
+                  YY_CAST (long, yystacksize)));
+      YY_IGNORE_USELESS_CAST_END
 
       if (yyss + yystacksize - 1 <= yyssp)
         YYABORT;
     }
+#endif /* !defined yyoverflow && !defined YYSTACK_RELOCATE */
 
-  YYDPRINTF ((stderr, "Entering state %d\n", yystate));
 
   if (yystate == YYFINAL)
     YYACCEPT;
 
   goto yybackup;
 
+
 /*-----------.
 | yybackup.  |
 `-----------*/
 yybackup:
-
   /* Do appropriate processing given the current state.  Read a
      lookahead token if we need one and don't already have one.  */
 
@@ -1518,18 +1644,30 @@ yybackup:
 
   /* Not known => get a lookahead token if don't already have one.  */
 
-  /* YYCHAR is either YYEMPTY or YYEOF or a valid lookahead symbol.  */
+  /* YYCHAR is either empty, or end-of-input, or a valid lookahead.  */
   if (yychar == YYEMPTY)
     {
-      YYDPRINTF ((stderr, "Reading a token: "));
-      yychar = yylex ();
+      YYDPRINTF ((stderr, "Reading a token\n"));
+      yychar = yylex (&yylval, &yylloc, ctx);
     }
 
   if (yychar <= YYEOF)
     {
-      yychar = yytoken = YYEOF;
+      yychar = YYEOF;
+      yytoken = YYSYMBOL_YYEOF;
       YYDPRINTF ((stderr, "Now at end of input.\n"));
     }
+  else if (yychar == YYerror)
+    {
+      /* The scanner already issued an error message, process directly
+         to error recovery.  But do not keep the error token as
+         lookahead, it is too special and may lead us to an endless
+         loop in error recovery. */
+      yychar = YYUNDEF;
+      yytoken = YYSYMBOL_YYerror;
+      yyerror_range[1] = yylloc;
+      goto yyerrlab1;
+    }
   else
     {
       yytoken = YYTRANSLATE (yychar);
@@ -1549,8 +1687,8 @@ yybackup:
     {
       if (yytable_value_is_error (yyn))
         goto yyerrlab;
-      YY_LAC_ESTABLISH;
       yyn = -yyn;
+      YY_LAC_ESTABLISH;
       goto yyreduce;
     }
 
@@ -1561,16 +1699,15 @@ yybackup:
 
   /* Shift the lookahead token.  */
   YY_SYMBOL_PRINT ("Shifting", yytoken, &yylval, &yylloc);
-
-  /* Discard the shifted token.  */
-  yychar = YYEMPTY;
-  YY_LAC_DISCARD ("shift");
-
   yystate = yyn;
   YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
   *++yyvsp = yylval;
   YY_IGNORE_MAYBE_UNINITIALIZED_END
   *++yylsp = yylloc;
+
+  /* Discard the shifted token.  */
+  yychar = YYEMPTY;
+  YY_LAC_DISCARD ("shift");
   goto yynewstate;
 
 
@@ -1585,7 +1722,7 @@ yydefault:
 
 
 /*-----------------------------.
-| yyreduce -- Do a reduction.  |
+| yyreduce -- do a reduction.  |
 `-----------------------------*/
 yyreduce:
   /* yyn is the number of a rule to reduce with.  */
@@ -1609,405 +1746,290 @@ yyreduce:
     int yychar_backup = yychar;
     switch (yyn)
       {
-          case 2:
-#line 51 "io/file_liberty.y" /* yacc.c:1651  */
-    { }
-#line 1616 "file_liberty.tab.c" /* yacc.c:1651  */
+  case 2: /* liberty: group  */
+#line 41 "io/file_liberty.y"
+              { }
+#line 1753 "file_liberty.tab.c"
     break;
 
-  case 8:
-#line 63 "io/file_liberty.y" /* yacc.c:1651  */
-    {
-            if (!strcmp((yyvsp[-3].sval), "date")) {
-            } else if (!strcmp((yyvsp[-3].sval), "revision")) {
-            } else if (!strcmp((yyvsp[-3].sval), "comment")) {
-            } else if (!strcmp((yyvsp[-3].sval), "delay_model")) {
-            } else if (!strcmp((yyvsp[-3].sval), "in_place_swap_mode")) {
-            } else if (!strcmp((yyvsp[-3].sval), "time_unit")) {
-            } else if (!strcmp((yyvsp[-3].sval), "leakage_power_unit")) {
-            } else if (!strcmp((yyvsp[-3].sval), "voltage_unit")) {
-            } else if (!strcmp((yyvsp[-3].sval), "current_unit")) {
-            } else if (!strcmp((yyvsp[-3].sval), "pulling_resistance_unit")) {
-            } else if (!strcmp((yyvsp[-3].sval), "process_corner")) {
-            } else if (!strcmp((yyvsp[-3].sval), "tree_type")) {
-            } else if (!strcmp((yyvsp[-3].sval), "default_operating_conditions")) {
-            } else if (!strcmp((yyvsp[-3].sval), "default_wire_load")) {
-            } else if (!strcmp((yyvsp[-3].sval), "variable_1")) {
-            } else if (!strcmp((yyvsp[-3].sval), "variable_2")) {
-            } else if (!strcmp((yyvsp[-3].sval), "variable_3")) {
-            } else if (!strcmp((yyvsp[-3].sval), "voltage_name")) {
-            } else if (!strcmp((yyvsp[-3].sval), "pg_type")) {
-            } else if (!strcmp((yyvsp[-3].sval), "when")) {
-            } else if (!strcmp((yyvsp[-3].sval), "direction")) {
-                if (!strcmp((yyvsp[-1].sval), "output")) {
-                    pindir = 'o';
-                } else if (!strcmp((yyvsp[-1].sval), "input")) {
-                    pindir = 'i';
-                } else if (!strcmp((yyvsp[-1].sval), "internal")) {
-                    pindir = 'n';
+  case 8: /* simple_attribute: STRING ':' STRING ';'  */
+#line 53 "io/file_liberty.y"
+                              {
+            switch (LibertyContext::key((yyvsp[-3].sval))) {
+            case LibertyKey::Direction:
+                if ((yyvsp[-1].sval) == "output") {
+                    ctx.pindir = 'o';
+                } else if ((yyvsp[-1].sval) == "input") {
+                    ctx.pindir = 'i';
+                } else if ((yyvsp[-1].sval) == "internal") {
+                    ctx.pindir = 'n';
                 } else {
-                    cout<<"unknown direction: "<<(yyvsp[-1].sval)<<endl;
-                    getchar();
+                    printlog(LOG_WARN, "%s:%u: unknown direction: %s", ctx.file.c_str(), ctx.line, string((yyvsp[-1].sval)).c_str());
                 }
-            } else if (!strcmp((yyvsp[-3].sval), "related_power_pin")) {
-            } else if (!strcmp((yyvsp[-3].sval), "related_ground_pin")) {
-            } else if (!strcmp((yyvsp[-3].sval), "function")) {
-            } else if (!strcmp((yyvsp[-3].sval), "related_pin")) {
-                timing.relatedPinName = (yyvsp[-1].sval);
-            } else if (!strcmp((yyvsp[-3].sval), "timing_sense")) {
-                if(strcmp((yyvsp[-1].sval), "negative_unate")==0){
-                    timing.timingSense = '-';
-                }else if(strcmp((yyvsp[-1].sval), "positive_unate")==0){
-                    timing.timingSense = '+';
-                }else if(strcmp((yyvsp[-1].sval), "non_unate")==0){
-                    timing.timingSense = 'x';
-                }else{
-                    cout<<"unknown timing sense: "<<(yyvsp[-1].sval)<<endl;
+                break;
+            case LibertyKey::RelatedPin:
+                ctx.timing.relatedPinName = (yyvsp[-1].sval);
+                break;
+            case LibertyKey::TimingSense:
+                if ((yyvsp[-1].sval) == "negative_unate") {
+                    ctx.timing.timingSense = '-';
+                } else if ((yyvsp[-1].sval) == "positive_unate") {
+                    ctx.timing.timingSense = '+';
+                } else if ((yyvsp[-1].sval) == "non_unate") {
+                    ctx.timing.timingSense = 'x';
+                } else {
+                    printlog(LOG_WARN, "%s:%u: unknown timing sense: %s", ctx.file.c_str(), ctx.line, string((yyvsp[-1].sval)).c_str());
                 }
-            } else if (!strcmp((yyvsp[-3].sval), "dont_touch")) {
-            } else if (!strcmp((yyvsp[-3].sval), "dont_use")) {
-            } else if (!strcmp((yyvsp[-3].sval), "sdf_cond")) {
-            } else if (!strcmp((yyvsp[-3].sval), "table")) {
-            } else if (!strcmp((yyvsp[-3].sval), "clock_gating_integrated_cell")) {
-            } else if (!strcmp((yyvsp[-3].sval), "internal_node")) {
-            } else if (!strcmp((yyvsp[-3].sval), "state_function")) {
-            } else if (!strcmp((yyvsp[-3].sval), "clock_gate_clock_pin")) {
-            } else if (!strcmp((yyvsp[-3].sval), "clock_gate_enable_pin")) {
-            } else if (!strcmp((yyvsp[-3].sval), "clock_gate_test_pin")) {
-            } else if (!strcmp((yyvsp[-3].sval), "clock_gate_out_pin")) {
-            } else if (!strcmp((yyvsp[-3].sval), "timing_type")) {
-            } else if (!strcmp((yyvsp[-3].sval), "clock")) {
-            } else if (!strcmp((yyvsp[-3].sval), "next_state")) {
-            } else if (!strcmp((yyvsp[-3].sval), "clocked_on")) {
-            } else if (!strcmp((yyvsp[-3].sval), "preset")) {
-            } else if (!strcmp((yyvsp[-3].sval), "clear")) {
-            } else if (!strcmp((yyvsp[-3].sval), "clear_preset_var1")) {
-            } else if (!strcmp((yyvsp[-3].sval), "clear_preset_var2")) {
-            } else if (!strcmp((yyvsp[-3].sval), "data_in")) {
-            } else if (!strcmp((yyvsp[-3].sval), "enable")) {
-            } else if (!strcmp((yyvsp[-3].sval), "three_state")) {
-            } else if (!strcmp((yyvsp[-3].sval), "driver_type")) {
-            }else if(strcmp((yyvsp[-3].sval), "nextstate_type")==0){
-            }else{
-                cout<<(yyvsp[-3].sval)<<" = "<<(yyvsp[-1].sval)<<endl;
+                break;
+            default:
+                break;
             }
         }
-#line 1696 "file_liberty.tab.c" /* yacc.c:1651  */
+#line 1789 "file_liberty.tab.c"
     break;
 
-  case 9:
-#line 138 "io/file_liberty.y" /* yacc.c:1651  */
-    {
-            if (!strcmp((yyvsp[-3].sval), "nom_process")) {
-            } else if (!strcmp((yyvsp[-3].sval), "nom_voltage")) {
-            } else if (!strcmp((yyvsp[-3].sval), "nom_temperature")) {
-            } else if (!strcmp((yyvsp[-3].sval), "process")) {
-            } else if (!strcmp((yyvsp[-3].sval), "voltage")) {
-            } else if (!strcmp((yyvsp[-3].sval), "temperature")) {
-            } else if (!strcmp((yyvsp[-3].sval), "slew_lower_threshold_pct_rise")) {
-            } else if (!strcmp((yyvsp[-3].sval), "slew_lower_threshold_pct_fall")) {
-            } else if (!strcmp((yyvsp[-3].sval), "slew_upper_threshold_pct_rise")) {
-            } else if (!strcmp((yyvsp[-3].sval), "slew_upper_threshold_pct_fall")) {
-            } else if (!strcmp((yyvsp[-3].sval), "slew_derate_from_library")) {
-            } else if (!strcmp((yyvsp[-3].sval), "input_threshold_pct_rise")) {
-            } else if (!strcmp((yyvsp[-3].sval), "input_threshold_pct_fall")) {
-            } else if (!strcmp((yyvsp[-3].sval), "output_threshold_pct_rise")) {
-            } else if (!strcmp((yyvsp[-3].sval), "output_threshold_pct_fall")) {
-            } else if (!strcmp((yyvsp[-3].sval), "default_leakage_power_density")) {
-            } else if (!strcmp((yyvsp[-3].sval), "default_cell_leakage_power")) {
-            } else if (!strcmp((yyvsp[-3].sval), "default_inout_pin_cap")) {
-            } else if (!strcmp((yyvsp[-3].sval), "default_input_pin_cap")) {
-            } else if (!strcmp((yyvsp[-3].sval), "default_output_pin_cap")) {
-            } else if (!strcmp((yyvsp[-3].sval), "default_fanout_load")) {
-            } else if (!strcmp((yyvsp[-3].sval), "default_max_transition")) {
-            } else if (!strcmp((yyvsp[-3].sval), "capacitance")) {
-                ipin.capacitance = (yyvsp[-1].dval);
-            } else if (!strcmp((yyvsp[-3].sval), "resistance")) {
-            } else if (!strcmp((yyvsp[-3].sval), "slope")) {
-            } else if (!strcmp((yyvsp[-3].sval), "drive_strength")) {
-                cell.drive_strength((yyvsp[-1].dval));
-            } else if (!strcmp((yyvsp[-3].sval), "area")) {
-            } else if (!strcmp((yyvsp[-3].sval), "value")) {
-            } else if (!strcmp((yyvsp[-3].sval), "cell_leakage_power")) {
-            } else if (!strcmp((yyvsp[-3].sval), "fall_capacitance")) {
-            } else if (!strcmp((yyvsp[-3].sval), "rise_capacitance")) {
-            } else if (!strcmp((yyvsp[-3].sval), "max_capacitance")) {
-                opin.max_capacitance = (yyvsp[-1].dval);
-            } else if (!strcmp((yyvsp[-3].sval), "min_capacitance")) {
-                opin.min_capacitance = (yyvsp[-1].dval);
-            } else if (!strcmp((yyvsp[-3].sval), "function")) {
-            } else if (!strcmp((yyvsp[-3].sval), "reference_time")) {
-            } else {
-                cout<<(yyvsp[-3].sval)<<" = "<<(yyvsp[-1].dval)<<endl;
+  case 9: /* simple_attribute: STRING ':' NUMBER ';'  */
+#line 84 "io/file_liberty.y"
+                              {
+            switch (LibertyContext::key((yyvsp[-3].sval))) {
+            case LibertyKey::Capacitance:
+                ctx.ipin.capacitance = (yyvsp[-1].dval);
+                break;
+            case LibertyKey::DriveStrength:
+                ctx.cell.drive_strength((yyvsp[-1].dval));
+                break;
+            case LibertyKey::MaxCapacitance:
+                ctx.opin.max_capacitance = (yyvsp[-1].dval);
+                break;
+            case LibertyKey::MinCapacitance:
+                ctx.opin.min_capacitance = (yyvsp[-1].dval);
+                break;
+            default:
+                break;
             }
         }
-#line 1745 "file_liberty.tab.c" /* yacc.c:1651  */
+#line 1812 "file_liberty.tab.c"
     break;
 
-  case 10:
-#line 182 "io/file_liberty.y" /* yacc.c:1651  */
-    {
-            if (!strcmp((yyvsp[-3].sval), "date")) {
-            } else {
-                cout << (yyvsp[-3].sval) << " = simple\n";
-            }
-        }
-#line 1756 "file_liberty.tab.c" /* yacc.c:1651  */
+  case 10: /* simple_attribute: STRING ':' value_list ';'  */
+#line 102 "io/file_liberty.y"
+                                  { }
+#line 1818 "file_liberty.tab.c"
     break;
 
-  case 11:
-#line 190 "io/file_liberty.y" /* yacc.c:1651  */
-    {
-            if (!strcmp((yyvsp[-4].sval), "technology")) {
-            } else {
-                cout << (yyvsp[-4].sval) << " = (\"" << (yyvsp[-2].sval) << "\")\n";
-            }
-        }
-#line 1767 "file_liberty.tab.c" /* yacc.c:1651  */
+  case 11: /* complex_attribute: STRING '(' STRING ')' ';'  */
+#line 105 "io/file_liberty.y"
+                                  { }
+#line 1824 "file_liberty.tab.c"
     break;
 
-  case 12:
-#line 196 "io/file_liberty.y" /* yacc.c:1651  */
-    {
-            if (!strcmp((yyvsp[-4].sval), "index_1")) {
-                lut.indexX = dvalues;
-                dvalues.clear();
-            } else if (!strcmp((yyvsp[-4].sval), "index_2")) {
-                lut.indexY = dvalues;
-                dvalues.clear();
-            } else if (!strcmp((yyvsp[-4].sval), "index_3")) {
-                lut.indexY = dvalues;
-                dvalues.clear();
-            } else if (!strcmp((yyvsp[-4].sval), "values")) {
-                lut.values.resize(1, vector<vector<double>>(1, vector<double>(1, (yyvsp[-2].dval))));
-            } else {
-                cout << (yyvsp[-4].sval) << " = (" << (yyvsp[-2].dval) << ")\n";
+  case 12: /* complex_attribute: STRING '(' NUMBER ')' ';'  */
+#line 106 "io/file_liberty.y"
+                                  {
+            switch (LibertyContext::key((yyvsp[-4].sval))) {
+            case LibertyKey::Index1:
+                ctx.lut.indexX = ctx.dvalues;
+                ctx.dvalues.clear();
+                break;
+            case LibertyKey::Index2:
+                ctx.lut.indexY = ctx.dvalues;
+                ctx.dvalues.clear();
+                break;
+            case LibertyKey::Index3:
+                ctx.lut.indexZ = ctx.dvalues;
+                ctx.dvalues.clear();
+                break;
+            case LibertyKey::Values:
+                if (ctx.lut.values.empty()) ctx.lut.set(1, 1, 1, {(yyvsp[-2].dval)});
+                break;
+            default:
+                break;
             }
         }
-#line 1788 "file_liberty.tab.c" /* yacc.c:1651  */
+#line 1850 "file_liberty.tab.c"
     break;
 
-  case 13:
-#line 212 "io/file_liberty.y" /* yacc.c:1651  */
-    {
-            if (!strcmp((yyvsp[-4].sval), "library_features")) {
-            } else if (!strcmp((yyvsp[-4].sval), "capacitive_load_unit")) {
-                dvalues.clear();
-                svalues.pop();
-            } else if (!strcmp((yyvsp[-4].sval), "voltage_map")) {
-            } else if (!strcmp((yyvsp[-4].sval), "define")) {
-            } else if (!strcmp((yyvsp[-4].sval), "fanout_length")) {
-            } else if (!strcmp((yyvsp[-4].sval), "index_1")) {
-                lut.indexX = dvalues;
-                dvalues.clear();
-            } else if (!strcmp((yyvsp[-4].sval), "index_2")) {
-                lut.indexY = dvalues;
-                dvalues.clear();
-            } else if (!strcmp((yyvsp[-4].sval), "index_3")) {
-                lut.indexY = dvalues;
-                dvalues.clear();
-            } else if (!strcmp((yyvsp[-4].sval), "values")) {
+  case 13: /* complex_attribute: STRING '(' value_list ')' ';'  */
+#line 127 "io/file_liberty.y"
+                                      {
+            switch (LibertyContext::key((yyvsp[-4].sval))) {
+            case LibertyKey::CapacitiveLoadUnit:
+                if (ctx.dvalues.size() && ctx.svalues.size()) {
+                    string unit(ctx.svalues.back());
+                    transform(unit.begin(), unit.end(), unit.begin(), ::tolower);
+                    if (unit == "ff") {
+                        ctx.liberty.capacitanceUnit = ctx.dvalues.back() * 1e-3;
+                    } else if (unit == "pf") {
+                        ctx.liberty.capacitanceUnit = ctx.dvalues.back();
+                    } else {
+                        printlog(LOG_WARN, "%s:%u: unknown capacitive load unit: %s", ctx.file.c_str(), ctx.line, unit.c_str());
+                    }
+                }
+                ctx.dvalues.clear();
+                ctx.svalues.pop_back();
+                break;
+            case LibertyKey::Index1:
+                ctx.lut.indexX = ctx.dvalues;
+                ctx.dvalues.clear();
+                break;
+            case LibertyKey::Index2:
+                ctx.lut.indexY = ctx.dvalues;
+                ctx.dvalues.clear();
+                break;
+            case LibertyKey::Index3:
+                ctx.lut.indexZ = ctx.dvalues;
+                ctx.dvalues.clear();
+                break;
+            case LibertyKey::Values: {
+                STALibraryLUT& lut = ctx.lut;
                 unsigned nx = max(1UL, lut.indexX.size());
                 unsigned ny = max(1UL, lut.indexY.size());
                 unsigned nz = max(1UL, lut.indexZ.size());
-                //  cout << dvalues.size() << '\t' << nx << '\t' << ny << endl;
-                if (dvalues.size() != nx * ny * nz) {
-                    yyerror("size not match");
-                }
-                unsigned i = 0;
-                lut.values.resize(nx, vector<vector<double>>(ny, vector<double>(nz, 0.0)));
-                for (vector<vector<double>>& value : lut.values) {
-                    for (vector<double>& val : value) {
-                        for (double& v : val) {
-                            v = dvalues[i++];
-                        }
-                    }
+                if (ctx.dvalues.size() != nx * ny * nz) {
+                    yyerror(&(yyloc), ctx, "size not match");
+                    YYABORT;
                 }
-                dvalues.clear();
-            }else{
-                cout<<(yyvsp[-4].sval)<<" = (complex)"<<endl;
+                lut.set(nx, ny, nz, move(ctx.dvalues));
+                ctx.dvalues.clear();
+                break;
+            }
+            default:
+                break;
             }
         }
-#line 1832 "file_liberty.tab.c" /* yacc.c:1651  */
+#line 1901 "file_liberty.tab.c"
     break;
 
-  case 16:
-#line 257 "io/file_liberty.y" /* yacc.c:1651  */
-    { svalues.push((yyvsp[0].sval)); }
-#line 1838 "file_liberty.tab.c" /* yacc.c:1651  */
+  case 16: /* value: STRING  */
+#line 179 "io/file_liberty.y"
+               { ctx.svalues.push_back((yyvsp[0].sval)); }
+#line 1907 "file_liberty.tab.c"
     break;
 
-  case 17:
-#line 258 "io/file_liberty.y" /* yacc.c:1651  */
-    { dvalues.push_back((yyvsp[0].dval)); }
-#line 1844 "file_liberty.tab.c" /* yacc.c:1651  */
+  case 17: /* value: NUMBER  */
+#line 180 "io/file_liberty.y"
+               { ctx.dvalues.push_back((yyvsp[0].dval)); }
+#line 1913 "file_liberty.tab.c"
     break;
 
-  case 18:
-#line 261 "io/file_liberty.y" /* yacc.c:1651  */
-    {
-            if (!strcmp((yyvsp[-5].sval), "leakage_power")) {
-            } else if (!strcmp((yyvsp[-5].sval), "timing")) {
-                opin.timings.push_back(timing);
-            } else if (!strcmp((yyvsp[-5].sval), "internal_power")) {
-            } else if (!strcmp((yyvsp[-5].sval), "output_current_fall")) {
-            } else if (!strcmp((yyvsp[-5].sval), "output_current_rise")) {
-            } else if (!strcmp((yyvsp[-5].sval), "receiver_capacitance")) {
-            } else {
-                cout <<"unknown group : " << (yyvsp[-5].sval) << endl;
+  case 18: /* group: STRING '(' ')' '{' statements '}'  */
+#line 183 "io/file_liberty.y"
+                                          {
+            if (LibertyContext::key((yyvsp[-5].sval)) == LibertyKey::Timing) {
+                ctx.opin.timings.push_back(ctx.timing);
             }
         }
-#line 1861 "file_liberty.tab.c" /* yacc.c:1651  */
+#line 1923 "file_liberty.tab.c"
     break;
 
-  case 19:
-#line 273 "io/file_liberty.y" /* yacc.c:1651  */
-    {
-            if (!strcmp((yyvsp[-6].sval), "library")) {
-                stalib->name = (yyvsp[-4].sval);
-            } else if (!strcmp((yyvsp[-6].sval), "operating_conditions")) {
-            } else if (!strcmp((yyvsp[-6].sval), "wire_load")) {
-            } else if (!strcmp((yyvsp[-6].sval), "power_lut_template")) {
-                lut.clear();
-            } else if (!strcmp((yyvsp[-6].sval), "lu_table_template")) {
-                lutTemplate = (yyvsp[-4].sval);
-                lut.clear();
-            } else if(!strcmp((yyvsp[-6].sval), "cell")) {
-                cell.name((yyvsp[-4].sval));
-                unordered_map<string, CellType*>::iterator mi = database.name_celltypes.find(cell.name());
-                if (mi != database.name_celltypes.end()) {
-                    STALibraryCell& libcell = stalib->cells[mi->second->libcell()];
-                    libcell.drive_strength(cell.drive_strength());
-                    for (const STALibraryIPin& ipin : cell.ipins) {
-                        bool ipFound = false;
-                        for (STALibraryIPin& libipin : libcell.ipins) {
-                            if(ipin.name() == libipin.name()) {
-                                libipin = move(ipin);
-                                ipFound = true;
-                                if (libcell.name() == "BUF_X4" && libipin.name() == "A") {
-                                    STALibraryIPin::default_capacitance = libipin.capacitance;
-                                }
-                                break;
-                            }
-                        }
-                        if (!ipFound) {
-                            cerr << "input pin not found: " << ipin.name() << endl;
-                        }
-                    }
-                    for (const STALibraryOPin& opin : cell.opins) {
-                        //  cout << opin.name() << '\t' << opin.max_capacitance << endl;
-                        bool opFound = false;
-                        for (STALibraryOPin& libopin : libcell.opins) {
-                            if (opin.name() == libopin.name()) {
-                                libopin = move(opin);
-                                opFound = true;
-                                if (libcell.name() == "BUF_X4" && libopin.name() == "Z") {
-                                    STALibraryOPin::default_max_capacitance = libopin.max_capacitance;
-                                }
-                                break;
-                            }
-                        }
-                        if (!opFound) {
-                            cerr << cell.name() << "\toutput pin not found: " << opin.name() << '\t' << opin.max_capacitance << endl;
-                            assert(false);
-                        }
-                    }
-                } else {
-                    cout << "not found: " << (yyvsp[-4].sval) << endl;
-                }
-                cell.name("");
-                cell.ipins.clear();
-                cell.opins.clear();
-            } else if (!strcmp((yyvsp[-6].sval), "pg_pin")) {
-            } else if (!strcmp((yyvsp[-6].sval), "pin")) {
-                switch (pindir) {
+  case 19: /* group: STRING '(' STRING ')' '{' statements '}'  */
+#line 188 "io/file_liberty.y"
+                                                 {
+            switch (LibertyContext::key((yyvsp[-6].sval))) {
+            case LibertyKey::Library:
+                ctx.liberty.library = (yyvsp[-4].sval);
+                break;
+            case LibertyKey::PowerLutTemplate:
+                ctx.lut.clear();
+                break;
+            case LibertyKey::LuTableTemplate:
+                ctx.lutTemplate = (yyvsp[-4].sval);
+                ctx.lut.clear();
+                break;
+            case LibertyKey::Cell: {
+                //  the drive strength carries over to the next cell, as it always did
+                const unsigned driveStrength = ctx.cell.drive_strength();
+                ctx.cell.name(string((yyvsp[-4].sval)));
+                ctx.liberty.cells.push_back(move(ctx.cell));
+                ctx.cell = STALibraryCell("", driveStrength);
+                break;
+            }
+            case LibertyKey::Pin:
+                switch (ctx.pindir) {
                 case 'i':
-                    ipin.name((yyvsp[-4].sval));
-                    cell.ipins.push_back(ipin);
+                    ctx.ipin.name(string((yyvsp[-4].sval)));
+                    ctx.cell.ipins.push_back(ctx.ipin);
                     break;
                 case 'n':
                     break;
                 case 'o':
-                    opin.name((yyvsp[-4].sval));
-                    cell.opins.push_back(opin);
-                    //  cout << pindir << ' ' << opin.name() << endl;
+                    ctx.opin.name(string((yyvsp[-4].sval)));
+                    ctx.cell.opins.push_back(ctx.opin);
                     break;
                 default:
-                    cout << "unknown pin type: " << pindir << endl;
+                    printlog(LOG_WARN, "%s:%u: unknown pin type: %c", ctx.file.c_str(), ctx.line, ctx.pindir);
                     break;
                 }
 
-                ipin.name("");
-                ipin.capacitance = 0.0;
-                opin.name("");
-                opin.min_capacitance = 0.0;
-                opin.max_capacitance = 0.0;
-                opin.timings.clear();
-                pindir = 'x';
-            } else if (!strcmp((yyvsp[-6].sval), "cell_fall")) {
-                if(strcmp((yyvsp[-4].sval), lutTemplate.c_str())==0){
-                    timing.delayFall = lut;
-                } else if (!strcmp((yyvsp[-4].sval), "scalar")) {
-                    timing.delayFall = STALibraryLUT(lut.values[0][0][0]);
+                ctx.ipin.name("");
+                ctx.ipin.capacitance = 0.0;
+                ctx.opin.name("");
+                ctx.opin.min_capacitance = 0.0;
+                ctx.opin.max_capacitance = 0.0;
+                ctx.opin.timings.clear();
+                ctx.pindir = 'x';
+                break;
+            case LibertyKey::CellFall:
+                if ((yyvsp[-4].sval) == ctx.lutTemplate) {
+                    ctx.timing.delayFall = ctx.lut;
+                } else if ((yyvsp[-4].sval) == "scalar") {
+                    ctx.timing.delayFall = STALibraryLUT(ctx.lut.values[0]);
                 }
-                lut.clear();
-            } else if (!strcmp((yyvsp[-6].sval), "cell_rise")) {
-                if(strcmp((yyvsp[-4].sval), lutTemplate.c_str())==0){
-                    timing.delayRise = lut;
-                } else if (!strcmp((yyvsp[-4].sval), "scalar")) {
-                    timing.delayRise = STALibraryLUT(lut.values[0][0][0]);
+                ctx.lut.clear();
+                break;
+            case LibertyKey::CellRise:
+                if ((yyvsp[-4].sval) == ctx.lutTemplate) {
+                    ctx.timing.delayRise = ctx.lut;
+                } else if ((yyvsp[-4].sval) == "scalar") {
+                    ctx.timing.delayRise = STALibraryLUT(ctx.lut.values[0]);
                 }
-                lut.clear();
-            } else if (!strcmp((yyvsp[-6].sval), "fall_transition")) {
-                if(strcmp((yyvsp[-4].sval), lutTemplate.c_str())==0){
-                    timing.slewFall = lut;
-                } else if (!strcmp((yyvsp[-4].sval), "scalar")) {
-                    timing.slewFall = STALibraryLUT(lut.values[0][0][0]);
+                ctx.lut.clear();
+                break;
+            case LibertyKey::FallTransition:
+                if ((yyvsp[-4].sval) == ctx.lutTemplate) {
+                    ctx.timing.slewFall = ctx.lut;
+                } else if ((yyvsp[-4].sval) == "scalar") {
+                    ctx.timing.slewFall = STALibraryLUT(ctx.lut.values[0]);
                 }
-                lut.clear();
-            } else if (!strcmp((yyvsp[-6].sval), "rise_transition")) {
-                if(strcmp((yyvsp[-4].sval), lutTemplate.c_str())==0){
-                    timing.slewRise = lut;
-                } else if(!strcmp((yyvsp[-4].sval), "scalar")) {
-                    timing.slewRise = STALibraryLUT(lut.values[0][0][0]);
+                ctx.lut.clear();
+                break;
+            case LibertyKey::RiseTransition:
+                if ((yyvsp[-4].sval) == ctx.lutTemplate) {
+                    ctx.timing.slewRise = ctx.lut;
+                } else if ((yyvsp[-4].sval) == "scalar") {
+                    ctx.timing.slewRise = STALibraryLUT(ctx.lut.values[0]);
                 }
-                lut.clear();
-            } else if (!strcmp((yyvsp[-6].sval), "fall_power")) {
-                lut.clear();
-            } else if (!strcmp((yyvsp[-6].sval), "rise_power")) {
-                lut.clear();
-            } else if (!strcmp((yyvsp[-6].sval), "rise_constraint")) {
-                lut.clear();
-            } else if (!strcmp((yyvsp[-6].sval), "fall_constraint")) {
-                lut.clear();
-            } else if (!strcmp((yyvsp[-6].sval), "output_current_template")) {
-            } else if (!strcmp((yyvsp[-6].sval), "receiver_capacitance1_fall")) {
-                lut.clear();
-            } else if (!strcmp((yyvsp[-6].sval), "receiver_capacitance1_rise")) {
-                lut.clear();
-            } else if (!strcmp((yyvsp[-6].sval), "receiver_capacitance2_fall")) {
-                lut.clear();
-            } else if (!strcmp((yyvsp[-6].sval), "receiver_capacitance2_rise")) {
-                lut.clear();
-            } else if (!strcmp((yyvsp[-6].sval), "vector")) {
-                lut.clear();
-            } else {
-                cout << "read group " << (yyvsp[-6].sval) << "() finish" << endl;
+                ctx.lut.clear();
+                break;
+            case LibertyKey::FallPower:
+            case LibertyKey::RisePower:
+            case LibertyKey::RiseConstraint:
+            case LibertyKey::FallConstraint:
+            case LibertyKey::ReceiverCapacitance1Fall:
+            case LibertyKey::ReceiverCapacitance1Rise:
+            case LibertyKey::ReceiverCapacitance2Fall:
+            case LibertyKey::ReceiverCapacitance2Rise:
+            case LibertyKey::Vector:
+                ctx.lut.clear();
+                break;
+            default:
+                break;
             }
         }
-#line 1999 "file_liberty.tab.c" /* yacc.c:1651  */
+#line 2020 "file_liberty.tab.c"
     break;
 
-  case 20:
-#line 406 "io/file_liberty.y" /* yacc.c:1651  */
-    {
+  case 20: /* group: STRING '(' value_list ')' '{' statements '}'  */
+#line 280 "io/file_liberty.y"
+                                                     {
             /* ignore ff group */
         }
-#line 2007 "file_liberty.tab.c" /* yacc.c:1651  */
+#line 2028 "file_liberty.tab.c"
     break;
 
 
-#line 2011 "file_liberty.tab.c" /* yacc.c:1651  */
+#line 2032 "file_liberty.tab.c"
+
         default: break;
       }
     if (yychar_backup != yychar)
@@ -2024,11 +2046,10 @@ yyreduce:
      case of YYERROR or YYBACKUP, subsequent parser actions might lead
      to an incorrect destructor call or verbose syntax error message
      before the lookahead is translated.  */
-  YY_SYMBOL_PRINT ("-> $$ =", yyr1[yyn], &yyval, &yyloc);
+  YY_SYMBOL_PRINT ("-> $$ =", YY_CAST (yysymbol_kind_t, yyr1[yyn]), &yyval, &yyloc);
 
   YYPOPSTACK (yylen);
   yylen = 0;
-  YY_STACK_PRINT (yyss, yyssp);
 
   *++yyvsp = yyval;
   *++yylsp = yyloc;
@@ -2036,14 +2057,13 @@ yyreduce:
   /* Now 'shift' the result of the reduction.  Determine what state
      that goes to, based on the state we popped back to and the rule
      number reduced by.  */
-
-  yyn = yyr1[yyn];
-
-  yystate = yypgoto[yyn - YYNTOKENS] + *yyssp;
-  if (0 <= yystate && yystate <= YYLAST && yycheck[yystate] == *yyssp)
-    yystate = yytable[yystate];
-  else
-    yystate = yydefgoto[yyn - YYNTOKENS];
+  {
+    const int yylhs = yyr1[yyn] - YYNTOKENS;
+    const int yyi = yypgoto[yylhs] + *yyssp;
+    yystate = (0 <= yyi && yyi <= YYLAST && yycheck[yyi] == *yyssp
+               ? yytable[yyi]
+               : yydefgoto[yylhs]);
+  }
 
   goto yynewstate;
 
@@ -2054,53 +2074,47 @@ yyreduce:
 yyerrlab:
   /* Make sure we have latest lookahead translation.  See comments at
      user semantic actions for why this is necessary.  */
-  yytoken = yychar == YYEMPTY ? YYEMPTY : YYTRANSLATE (yychar);
-
+  yytoken = yychar == YYEMPTY ? YYSYMBOL_YYEMPTY : YYTRANSLATE (yychar);
   /* If not already recovering from an error, report this error.  */
   if (!yyerrstatus)
     {
       ++yynerrs;
-#if ! YYERROR_VERBOSE
-      yyerror (YY_("syntax error"));
-#else
-# define YYSYNTAX_ERROR yysyntax_error (&yymsg_alloc, &yymsg, \
-                                        yyesa, &yyes, &yyes_capacity, \
-                                        yyssp, yytoken)
       {
+        yypcontext_t yyctx
+          = {yyssp, yyesa, &yyes, &yyes_capacity, yytoken, &yylloc};
         char const *yymsgp = YY_("syntax error");
         int yysyntax_error_status;
         if (yychar != YYEMPTY)
           YY_LAC_ESTABLISH;
-        yysyntax_error_status = YYSYNTAX_ERROR;
+        yysyntax_error_status = yysyntax_error (&yymsg_alloc, &yymsg, &yyctx);
         if (yysyntax_error_status == 0)
           yymsgp = yymsg;
-        else if (yysyntax_error_status == 1)
+        else if (yysyntax_error_status == -1)
           {
             if (yymsg != yymsgbuf)
               YYSTACK_FREE (yymsg);
-            yymsg = (char *) YYSTACK_ALLOC (yymsg_alloc);
-            if (!yymsg)
+            yymsg = YY_CAST (char *,
+                             YYSTACK_ALLOC (YY_CAST (YYSIZE_T, yymsg_alloc)));
+            if (yymsg)
               {
-                yymsg = yymsgbuf;
-                yymsg_alloc = sizeof yymsgbuf;
-                yysyntax_error_status = 2;
+                yysyntax_error_status
+                  = yysyntax_error (&yymsg_alloc, &yymsg, &yyctx);
+                yymsgp = yymsg;
               }
             else
               {
-                yysyntax_error_status = YYSYNTAX_ERROR;
-                yymsgp = yymsg;
+                yymsg = yymsgbuf;
+                yymsg_alloc = sizeof yymsgbuf;
+                yysyntax_error_status = YYENOMEM;
               }
           }
-        yyerror (yymsgp);
-        if (yysyntax_error_status == 2)
-          goto yyexhaustedlab;
+        yyerror (&yylloc, ctx, yymsgp);
+        if (yysyntax_error_status == YYENOMEM)
+          YYNOMEM;
       }
-# undef YYSYNTAX_ERROR
-#endif
     }
 
   yyerror_range[1] = yylloc;
-
   if (yyerrstatus == 3)
     {
       /* If just tried and failed to reuse lookahead token after an
@@ -2115,7 +2129,7 @@ yyerrlab:
       else
         {
           yydestruct ("Error: discarding",
-                      yytoken, &yylval, &yylloc);
+                      yytoken, &yylval, &yylloc, ctx);
           yychar = YYEMPTY;
         }
     }
@@ -2129,12 +2143,11 @@ yyerrlab:
 | yyerrorlab -- error raised explicitly by YYERROR.  |
 `---------------------------------------------------*/
 yyerrorlab:
-
-  /* Pacify compilers like GCC when the user code never invokes
-     YYERROR and the label yyerrorlab therefore never appears in user
-     code.  */
-  if (/*CONSTCOND*/ 0)
-     goto yyerrorlab;
+  /* Pacify compilers when the user code never invokes YYERROR and the
+     label yyerrorlab therefore never appears in user code.  */
+  if (0)
+    YYERROR;
+  ++yynerrs;
 
   /* Do not reclaim the symbols of the rule whose action triggered
      this YYERROR.  */
@@ -2151,13 +2164,14 @@ yyerrorlab:
 yyerrlab1:
   yyerrstatus = 3;      /* Each real token shifted decrements this.  */
 
+  /* Pop stack until we find a state that shifts the error token.  */
   for (;;)
     {
       yyn = yypact[yystate];
       if (!yypact_value_is_default (yyn))
         {
-          yyn += YYTERROR;
-          if (0 <= yyn && yyn <= YYLAST && yycheck[yyn] == YYTERROR)
+          yyn += YYSYMBOL_YYerror;
+          if (0 <= yyn && yyn <= YYLAST && yycheck[yyn] == YYSYMBOL_YYerror)
             {
               yyn = yytable[yyn];
               if (0 < yyn)
@@ -2171,7 +2185,7 @@ yyerrlab1:
 
       yyerror_range[1] = *yylsp;
       yydestruct ("Error: popping",
-                  yystos[yystate], yyvsp, yylsp);
+                  YY_ACCESSING_SYMBOL (yystate), yyvsp, yylsp, ctx);
       YYPOPSTACK (1);
       yystate = *yyssp;
       YY_STACK_PRINT (yyss, yyssp);
@@ -2186,13 +2200,11 @@ yyerrlab1:
   YY_IGNORE_MAYBE_UNINITIALIZED_END
 
   yyerror_range[2] = yylloc;
-  /* Using YYLLOC is tempting, but would change the location of
-     the lookahead.  YYLOC is available though.  */
-  YYLLOC_DEFAULT (yyloc, yyerror_range, 2);
-  *++yylsp = yyloc;
+  ++yylsp;
+  YYLLOC_DEFAULT (*yylsp, yyerror_range, 2);
 
   /* Shift the error token.  */
-  YY_SYMBOL_PRINT ("Shifting", yystos[yyn], yyvsp, yylsp);
+  YY_SYMBOL_PRINT ("Shifting", YY_ACCESSING_SYMBOL (yyn), yyvsp, yylsp);
 
   yystate = yyn;
   goto yynewstate;
@@ -2203,33 +2215,37 @@ yyerrlab1:
 `-------------------------------------*/
 yyacceptlab:
   yyresult = 0;
-  goto yyreturn;
+  goto yyreturnlab;
+
 
 /*-----------------------------------.
 | yyabortlab -- YYABORT comes here.  |
 `-----------------------------------*/
 yyabortlab:
   yyresult = 1;
-  goto yyreturn;
+  goto yyreturnlab;
 
-#if 1
-/*-------------------------------------------------.
-| yyexhaustedlab -- memory exhaustion comes here.  |
-`-------------------------------------------------*/
+
+/*-----------------------------------------------------------.
+| yyexhaustedlab -- YYNOMEM (memory exhaustion) comes here.  |
+`-----------------------------------------------------------*/
 yyexhaustedlab:
-  yyerror (YY_("memory exhausted"));
+  yyerror (&yylloc, ctx, YY_("memory exhausted"));
   yyresult = 2;
-  /* Fall through.  */
-#endif
+  goto yyreturnlab;
+
 
-yyreturn:
+/*----------------------------------------------------------.
+| yyreturnlab -- parsing is finished, clean up and return.  |
+`----------------------------------------------------------*/
+yyreturnlab:
   if (yychar != YYEMPTY)
     {
       /* Make sure we have latest lookahead translation.  See comments at
          user semantic actions for why this is necessary.  */
       yytoken = YYTRANSLATE (yychar);
       yydestruct ("Cleanup: discarding lookahead",
-                  yytoken, &yylval, &yylloc);
+                  yytoken, &yylval, &yylloc, ctx);
     }
   /* Do not reclaim the symbols of the rule whose action triggered
      this YYABORT or YYACCEPT.  */
@@ -2238,7 +2254,7 @@ yyreturn:
   while (yyssp != yyss)
     {
       yydestruct ("Cleanup: popping",
-                  yystos[*yyssp], yyvsp, yylsp);
+                  YY_ACCESSING_SYMBOL (+*yyssp), yyvsp, yylsp, ctx);
       YYPOPSTACK (1);
     }
 #ifndef yyoverflow
@@ -2247,43 +2263,103 @@ yyreturn:
 #endif
   if (yyes != yyesa)
     YYSTACK_FREE (yyes);
-#if YYERROR_VERBOSE
   if (yymsg != yymsgbuf)
     YYSTACK_FREE (yymsg);
-#endif
   return yyresult;
 }
-#line 411 "io/file_liberty.y" /* yacc.c:1910  */
+
+#line 285 "io/file_liberty.y"
 
 
-void read_liberty(STALibrary *lib, const string& filename)
+bool io::parseLiberty(const string& file, LibertyCells& liberty)
 {
-    FILE *fp = fopen(filename.c_str(), "r");
-    if(!fp){
-        cerr<<"open file fail: "<<filename<<" : "
-            <<__FILE__<<":"<<__LINE__<<endl;
-        return;
+    MappedFile mapped;
+    if (!mapped.open(file)) {
+        printlog(LOG_ERROR, "Unable to open Liberty file: %s", file.c_str());
+        return false;
     }
-    yyin = fp;
-    stalib = lib;
-    while(!feof(yyin)){
-        yyparse();
+
+#ifndef NDEBUG
+    printlog(LOG_INFO, "reading %s", file.c_str());
+#endif
+
+    LibertyContext ctx(liberty, file, mapped.begin(), mapped.end());
+    if (yyparse(ctx) || ctx.failed) {
+        printlog(LOG_ERROR, "Error in reading Liberty");
+        return false;
     }
-    fclose(fp);
-    lib->postLoad();
+    return true;
 }
 
-bool Database::readLiberty(const string& filename)
+namespace {
+//  Bind the parsed cells of `file` to the LEF cell types: their library cells in `rlib`, the capacitances of their
+//  pin types and the default capacitances. Unlike the parse, this writes process-wide state and runs alone.
+void bindLiberty(Database& db, const LibertyCells& liberty, const string& file)
 {
-    read_liberty(&(rlib), filename);
-    return true;
+    STALibrary& lib = rlib;
+    lib.name = liberty.library;
+    lib.capacitanceUnit = liberty.capacitanceUnit;
+    unsigned nUnknownCells = 0;
+    for (const STALibraryCell& cell : liberty.cells) {
+        unordered_map<string, CellType*>::iterator mi = db.name_celltypes.find(cell.name());
+        if (mi == db.name_celltypes.end()) {
+            ++nUnknownCells;
+            continue;
+        }
+        STALibraryCell& libcell = lib.cells[mi->second->libcell()];
+        libcell.drive_strength(cell.drive_strength());
+        for (const STALibraryIPin& ipin : cell.ipins) {
+            bool ipFound = false;
+            for (STALibraryIPin& libipin : libcell.ipins) {
+                if (ipin.name() == libipin.name()) {
+                    libipin = ipin;
+                    ipFound = true;
+                    for (PinType* pintype : mi->second->pins) {
+                        if (pintype->name() == ipin.name()) pintype->capacitance(ipin.capacitance);
+                    }
+                    if (libcell.name() == "BUF_X4" && libipin.name() == "A") {
+                        STALibraryIPin::default_capacitance = libipin.capacitance;
+                    }
+                    break;
+                }
+            }
+            if (!ipFound) {
+                printlog(LOG_WARN, "%s input pin not found: %s", cell.name().c_str(), ipin.name().c_str());
+            }
+        }
+        for (const STALibraryOPin& opin : cell.opins) {
+            bool opFound = false;
+            for (STALibraryOPin& libopin : libcell.opins) {
+                if (opin.name() == libopin.name()) {
+                    libopin = opin;
+                    opFound = true;
+                    if (libcell.name() == "BUF_X4" && libopin.name() == "Z") {
+                        STALibraryOPin::default_max_capacitance = libopin.max_capacitance;
+                    }
+                    break;
+                }
+            }
+            if (!opFound) {
+                printlog(LOG_ERROR, "%s output pin not found: %s", cell.name().c_str(), opin.name().c_str());
+            }
+        }
+    }
+    if (nUnknownCells) {
+        printlog(LOG_WARN, "%u cells of %s are not in LEF", nUnknownCells, file.c_str());
+    }
+    lib.postLoad();
 }
+}  // namespace
 
-/*
-void read_liberty_benchmark(STATimer *timer)
+bool Database::readLiberty(const string& file)
 {
-    read_liberty(&(timer->lLib), setting.benchmark_dir+setting.lib_late);
-    read_liberty(&(timer->eLib), setting.benchmark_dir+setting.lib_early);
+    LibertyCells liberty;
+    const string cache = IOModule::LibertyCache.empty() ? "" : libertyCachePath(IOModule::LibertyCache, file);
+    if (cache.empty() || !readLibertyCache(cache, file, liberty)) {
+        liberty = LibertyCells();
+        if (!parseLiberty(file, liberty)) return false;
+        if (!cache.empty() && !IOModule::writeDir(IOModule::LibertyCache)) writeLibertyCache(cache, file, liberty);
+    }
+    bindLiberty(*this, liberty, file);
+    return true;
 }
-*/
-
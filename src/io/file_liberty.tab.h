@@ -1,8 +1,9 @@
-/* A Bison parser, made by GNU Bison 3.1.  */
+/* A Bison parser, made by GNU Bison 3.8.2.  */
 
 /* Bison interface for Yacc-like parsers in C
 
-   Copyright (C) 1984, 1989-1990, 2000-2015, 2018 Free Software Foundation, Inc.
+   Copyright (C) 1984, 1989-1990, 2000-2015, 2018-2021 Free Software Foundation,
+   Inc.
 
    This program is free software: you can redistribute it and/or modify
    it under the terms of the GNU General Public License as published by
@@ -15,7 +16,7 @@
    GNU General Public License for more details.
 
    You should have received a copy of the GNU General Public License
-   along with this program.  If not, see <http://www.gnu.org/licenses/>.  */
+   along with this program.  If not, see <https://www.gnu.org/licenses/>.  */
 
 /* As a special exception, you may create a larger work that contains
    part or all of the Bison parser skeleton and distribute that work
@@ -30,6 +31,10 @@
    This special exception was added by the Free Software Foundation in
    version 2.2 of Bison.  */
 
+/* DO NOT RELY ON FEATURES THAT ARE NOT DOCUMENTED in the manual,
+   especially those whose name start with YY_ or yy_.  They are
+   private implementation details that can be changed or removed.  */
+
 #ifndef YY_FILE_LIBERTY_FILE_LIBERTY_TAB_H_INCLUDED
 # define YY_FILE_LIBERTY_FILE_LIBERTY_TAB_H_INCLUDED
 /* Debug traces.  */
@@ -39,32 +44,33 @@
 #if YYDEBUG
 extern int file_libertydebug;
 #endif
+/* "%code requires" blocks.  */
+#line 1 "io/file_liberty.y"
+
+
+#include "file_liberty.h"
+
 
-/* Token type.  */
+#line 55 "file_liberty.tab.h"
+
+/* Token kinds.  */
 #ifndef YYTOKENTYPE
 # define YYTOKENTYPE
   enum yytokentype
   {
-    NUMBER = 258,
-    STRING = 259
+    YYEMPTY = -2,
+    YYEOF = 0,                     /* "end of file"  */
+    YYerror = 256,                 /* error  */
+    YYUNDEF = 257,                 /* "invalid token"  */
+    NUMBER = 258,                  /* NUMBER  */
+    STRING = 259                   /* STRING  */
   };
+  typedef enum yytokentype yytoken_kind_t;
 #endif
 
 /* Value type.  */
 #if ! defined YYSTYPE && ! defined YYSTYPE_IS_DECLARED
-
-union YYSTYPE
-{
-#line 40 "io/file_liberty.y" /* yacc.c:1913  */
-
-    double  dval;
-    char *  sval;
-    int     token;
-
-#line 65 "file_liberty.tab.h" /* yacc.c:1913  */
-};
-
-typedef union YYSTYPE YYSTYPE;
+typedef io::LibertyValue YYSTYPE;
 # define YYSTYPE_IS_TRIVIAL 1
 # define YYSTYPE_IS_DECLARED 1
 #endif
@@ -84,8 +90,9 @@ struct YYLTYPE
 #endif
 
 
-extern YYSTYPE file_libertylval;
-extern YYLTYPE file_libertylloc;
-int file_libertyparse (void);
+
+
+int file_libertyparse (io::LibertyContext& ctx);
+
 
 #endif /* !YY_FILE_LIBERTY_FILE_LIBERTY_TAB_H_INCLUDED  */
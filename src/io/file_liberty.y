@@ -1,53 +1,43 @@
-%{
+%code requires {
 
-#include "../db/db.h"
-#include "../global.h"
-#include "../sta/sta.h"
+#include "file_liberty.h"
 
-using namespace db;
-using namespace sta;
+}
 
-#define yylex   file_libertylex
-#define yyparse file_libertyparse
-#define yyin    file_libertyin
-#define yyerror file_libertyerror
+%define api.pure full
+%define api.value.type {io::LibertyValue}
+%define parse.error verbose
+%define parse.lac full
+%locations
+%param {io::LibertyContext& ctx}
 
-extern "C" int yylex();
-extern "C" int yyparse();
-extern "C" FILE *yyin;
+%code {
 
-STALibrary *stalib;
-string lutTemplate;
-char pindir='x';
-STALibraryTiming timing;
-STALibraryIPin ipin;
-STALibraryOPin opin;
-STALibraryCell cell;
-STALibraryLUT lut;
-stack<string> svalues;
-vector<double> dvalues;
+#include "../global.h"
+#include "io.h"
+#include "utils.h"
 
-//%define api.prefix {liberty}
+using namespace db;
+using namespace io;
+using namespace sta;
 
-void yyerror(const char *s);
+//  attribute and group names are dispatched through the perfect hash in LibertyContext::key
 
-%}
+int yylex(YYSTYPE* value, YYLTYPE* location, LibertyContext& ctx) {
+    const int token = ctx.lex(*value);
+    location->first_line = location->last_line = ctx.line;
+    return token;
+}
 
-%define parse.error verbose
-%define parse.lac full
-%locations
+void yyerror(YYLTYPE* location, LibertyContext& ctx, const char* s) { ctx.error(s); }
 
-%union{
-    double  dval;
-    char *  sval;
-    int     token;
 }
 
 %token <dval> NUMBER
 %token <sval> STRING
 
 %%
-liberty: 
+liberty:
         group { }
 ;
 statements:
@@ -61,191 +51,123 @@ statement:
 ;
 simple_attribute:
         STRING ':' STRING ';' {
-            if (!strcmp($1, "date")) {
-            } else if (!strcmp($1, "revision")) {
-            } else if (!strcmp($1, "comment")) {
-            } else if (!strcmp($1, "delay_model")) {
-            } else if (!strcmp($1, "in_place_swap_mode")) {
-            } else if (!strcmp($1, "time_unit")) {
-            } else if (!strcmp($1, "leakage_power_unit")) {
-            } else if (!strcmp($1, "voltage_unit")) {
-            } else if (!strcmp($1, "current_unit")) {
-            } else if (!strcmp($1, "pulling_resistance_unit")) {
-            } else if (!strcmp($1, "process_corner")) {
-            } else if (!strcmp($1, "tree_type")) {
-            } else if (!strcmp($1, "default_operating_conditions")) {
-            } else if (!strcmp($1, "default_wire_load")) {
-            } else if (!strcmp($1, "variable_1")) {
-            } else if (!strcmp($1, "variable_2")) {
-            } else if (!strcmp($1, "variable_3")) {
-            } else if (!strcmp($1, "voltage_name")) {
-            } else if (!strcmp($1, "pg_type")) {
-            } else if (!strcmp($1, "when")) {
-            } else if (!strcmp($1, "direction")) {
-                if (!strcmp($3, "output")) {
-                    pindir = 'o';
-                } else if (!strcmp($3, "input")) {
-                    pindir = 'i';
-                } else if (!strcmp($3, "internal")) {
-                    pindir = 'n';
+            switch (LibertyContext::key($1)) {
+            case LibertyKey::Direction:
+                if ($3 == "output") {
+                    ctx.pindir = 'o';
+                } else if ($3 == "input") {
+                    ctx.pindir = 'i';
+                } else if ($3 == "internal") {
+                    ctx.pindir = 'n';
                 } else {
-                    cout<<"unknown direction: "<<$3<<endl;
-                    getchar();
+                    printlog(LOG_WARN, "%s:%u: unknown direction: %s", ctx.file.c_str(), ctx.line, string($3).c_str());
                 }
-            } else if (!strcmp($1, "related_power_pin")) {
-            } else if (!strcmp($1, "related_ground_pin")) {
-            } else if (!strcmp($1, "function")) {
-            } else if (!strcmp($1, "related_pin")) {
-                timing.relatedPinName = $3;
-            } else if (!strcmp($1, "timing_sense")) {
-                if(strcmp($3, "negative_unate")==0){
-                    timing.timingSense = '-';
-                }else if(strcmp($3, "positive_unate")==0){
-                    timing.timingSense = '+';
-                }else if(strcmp($3, "non_unate")==0){
-                    timing.timingSense = 'x';
-                }else{
-                    cout<<"unknown timing sense: "<<$3<<endl;
+                break;
+            case LibertyKey::RelatedPin:
+                ctx.timing.relatedPinName = $3;
+                break;
+            case LibertyKey::TimingSense:
+                if ($3 == "negative_unate") {
+                    ctx.timing.timingSense = '-';
+                } else if ($3 == "positive_unate") {
+                    ctx.timing.timingSense = '+';
+                } else if ($3 == "non_unate") {
+                    ctx.timing.timingSense = 'x';
+                } else {
+                    printlog(LOG_WARN, "%s:%u: unknown timing sense: %s", ctx.file.c_str(), ctx.line, string($3).c_str());
                 }
-            } else if (!strcmp($1, "dont_touch")) {
-            } else if (!strcmp($1, "dont_use")) {
-            } else if (!strcmp($1, "sdf_cond")) {
-            } else if (!strcmp($1, "table")) {
-            } else if (!strcmp($1, "clock_gating_integrated_cell")) {
-            } else if (!strcmp($1, "internal_node")) {
-            } else if (!strcmp($1, "state_function")) {
-            } else if (!strcmp($1, "clock_gate_clock_pin")) {
-            } else if (!strcmp($1, "clock_gate_enable_pin")) {
-            } else if (!strcmp($1, "clock_gate_test_pin")) {
-            } else if (!strcmp($1, "clock_gate_out_pin")) {
-            } else if (!strcmp($1, "timing_type")) {
-            } else if (!strcmp($1, "clock")) {
-            } else if (!strcmp($1, "next_state")) {
-            } else if (!strcmp($1, "clocked_on")) {
-            } else if (!strcmp($1, "preset")) {
-            } else if (!strcmp($1, "clear")) {
-            } else if (!strcmp($1, "clear_preset_var1")) {
-            } else if (!strcmp($1, "clear_preset_var2")) {
-            } else if (!strcmp($1, "data_in")) {
-            } else if (!strcmp($1, "enable")) {
-            } else if (!strcmp($1, "three_state")) {
-            } else if (!strcmp($1, "driver_type")) {
-            }else if(strcmp($1, "nextstate_type")==0){
-            }else{
-                cout<<$1<<" = "<<$3<<endl;
+                break;
+            default:
+                break;
             }
         }
     |   STRING ':' NUMBER ';' {
-            if (!strcmp($1, "nom_process")) {
-            } else if (!strcmp($1, "nom_voltage")) {
-            } else if (!strcmp($1, "nom_temperature")) {
-            } else if (!strcmp($1, "process")) {
-            } else if (!strcmp($1, "voltage")) {
-            } else if (!strcmp($1, "temperature")) {
-            } else if (!strcmp($1, "slew_lower_threshold_pct_rise")) {
-            } else if (!strcmp($1, "slew_lower_threshold_pct_fall")) {
-            } else if (!strcmp($1, "slew_upper_threshold_pct_rise")) {
-            } else if (!strcmp($1, "slew_upper_threshold_pct_fall")) {
-            } else if (!strcmp($1, "slew_derate_from_library")) {
-            } else if (!strcmp($1, "input_threshold_pct_rise")) {
-            } else if (!strcmp($1, "input_threshold_pct_fall")) {
-            } else if (!strcmp($1, "output_threshold_pct_rise")) {
-            } else if (!strcmp($1, "output_threshold_pct_fall")) {
-            } else if (!strcmp($1, "default_leakage_power_density")) {
-            } else if (!strcmp($1, "default_cell_leakage_power")) {
-            } else if (!strcmp($1, "default_inout_pin_cap")) {
-            } else if (!strcmp($1, "default_input_pin_cap")) {
-            } else if (!strcmp($1, "default_output_pin_cap")) {
-            } else if (!strcmp($1, "default_fanout_load")) {
-            } else if (!strcmp($1, "default_max_transition")) {
-            } else if (!strcmp($1, "capacitance")) {
-                ipin.capacitance = $3;
-            } else if (!strcmp($1, "resistance")) {
-            } else if (!strcmp($1, "slope")) {
-            } else if (!strcmp($1, "drive_strength")) {
-                cell.drive_strength($3);
-            } else if (!strcmp($1, "area")) {
-            } else if (!strcmp($1, "value")) {
-            } else if (!strcmp($1, "cell_leakage_power")) {
-            } else if (!strcmp($1, "fall_capacitance")) {
-            } else if (!strcmp($1, "rise_capacitance")) {
-            } else if (!strcmp($1, "max_capacitance")) {
-                opin.max_capacitance = $3;
-            } else if (!strcmp($1, "min_capacitance")) {
-                opin.min_capacitance = $3;
-            } else if (!strcmp($1, "function")) {
-            } else if (!strcmp($1, "reference_time")) {
-            } else {
-                cout<<$1<<" = "<<$3<<endl;
-            }
-        }
-    |   STRING ':' value_list ';' {
-            if (!strcmp($1, "date")) {
-            } else {
-                cout << $1 << " = simple\n";
+            switch (LibertyContext::key($1)) {
+            case LibertyKey::Capacitance:
+                ctx.ipin.capacitance = $3;
+                break;
+            case LibertyKey::DriveStrength:
+                ctx.cell.drive_strength($3);
+                break;
+            case LibertyKey::MaxCapacitance:
+                ctx.opin.max_capacitance = $3;
+                break;
+            case LibertyKey::MinCapacitance:
+                ctx.opin.min_capacitance = $3;
+                break;
+            default:
+                break;
             }
         }
+    |   STRING ':' value_list ';' { }
 ;
 complex_attribute:
-        STRING '(' STRING ')' ';' {
-            if (!strcmp($1, "technology")) {
-            } else {
-                cout << $1 << " = (\"" << $3 << "\")\n";
-            }
-        }
+        STRING '(' STRING ')' ';' { }
     |   STRING '(' NUMBER ')' ';' {
-            if (!strcmp($1, "index_1")) {
-                lut.indexX = dvalues;
-                dvalues.clear();
-            } else if (!strcmp($1, "index_2")) {
-                lut.indexY = dvalues;
-                dvalues.clear();
-            } else if (!strcmp($1, "index_3")) {
-                lut.indexY = dvalues;
-                dvalues.clear();
-            } else if (!strcmp($1, "values")) {
-                lut.values.resize(1, vector<vector<double>>(1, vector<double>(1, $3)));
-            } else {
-                cout << $1 << " = (" << $3 << ")\n";
+            switch (LibertyContext::key($1)) {
+            case LibertyKey::Index1:
+                ctx.lut.indexX = ctx.dvalues;
+                ctx.dvalues.clear();
+                break;
+            case LibertyKey::Index2:
+                ctx.lut.indexY = ctx.dvalues;
+                ctx.dvalues.clear();
+                break;
+            case LibertyKey::Index3:
+                ctx.lut.indexZ = ctx.dvalues;
+                ctx.dvalues.clear();
+                break;
+            case LibertyKey::Values:
+                if (ctx.lut.values.empty()) ctx.lut.set(1, 1, 1, {$3});
+                break;
+            default:
+                break;
             }
         }
     |   STRING '(' value_list ')' ';' {
-            if (!strcmp($1, "library_features")) {
-            } else if (!strcmp($1, "capacitive_load_unit")) {
-                dvalues.clear();
-                svalues.pop();
-            } else if (!strcmp($1, "voltage_map")) {
-            } else if (!strcmp($1, "define")) {
-            } else if (!strcmp($1, "fanout_length")) {
-            } else if (!strcmp($1, "index_1")) {
-                lut.indexX = dvalues;
-                dvalues.clear();
-            } else if (!strcmp($1, "index_2")) {
-                lut.indexY = dvalues;
-                dvalues.clear();
-            } else if (!strcmp($1, "index_3")) {
-                lut.indexY = dvalues;
-                dvalues.clear();
-            } else if (!strcmp($1, "values")) {
+            switch (LibertyContext::key($1)) {
+            case LibertyKey::CapacitiveLoadUnit:
+                if (ctx.dvalues.size() && ctx.svalues.size()) {
+                    string unit(ctx.svalues.back());
+                    transform(unit.begin(), unit.end(), unit.begin(), ::tolower);
+                    if (unit == "ff") {
+                        ctx.liberty.capacitanceUnit = ctx.dvalues.back() * 1e-3;
+                    } else if (unit == "pf") {
+                        ctx.liberty.capacitanceUnit = ctx.dvalues.back();
+                    } else {
+                        printlog(LOG_WARN, "%s:%u: unknown capacitive load unit: %s", ctx.file.c_str(), ctx.line, unit.c_str());
+                    }
+                }
+                ctx.dvalues.clear();
+                ctx.svalues.pop_back();
+                break;
+            case LibertyKey::Index1:
+                ctx.lut.indexX = ctx.dvalues;
+                ctx.dvalues.clear();
+                break;
+            case LibertyKey::Index2:
+                ctx.lut.indexY = ctx.dvalues;
+                ctx.dvalues.clear();
+                break;
+            case LibertyKey::Index3:
+                ctx.lut.indexZ = ctx.dvalues;
+                ctx.dvalues.clear();
+                break;
+            case LibertyKey::Values: {
+                STALibraryLUT& lut = ctx.lut;
                 unsigned nx = max(1UL, lut.indexX.size());
                 unsigned ny = max(1UL, lut.indexY.size());
                 unsigned nz = max(1UL, lut.indexZ.size());
-                //  cout << dvalues.size() << '\t' << nx << '\t' << ny << endl;
-                if (dvalues.size() != nx * ny * nz) {
-                    yyerror("size not match");
-                }
-                unsigned i = 0;
-                lut.values.resize(nx, vector<vector<double>>(ny, vector<double>(nz, 0.0)));
-                for (vector<vector<double>>& value : lut.values) {
-                    for (vector<double>& val : value) {
-                        for (double& v : val) {
-                            v = dvalues[i++];
-                        }
-                    }
+                if (ctx.dvalues.size() != nx * ny * nz) {
+                    yyerror(&@$, ctx, "size not match");
+                    YYABORT;
                 }
-                dvalues.clear();
-            }else{
-                cout<<$1<<" = (complex)"<<endl;
+                lut.set(nx, ny, nz, move(ctx.dvalues));
+                ctx.dvalues.clear();
+                break;
+            }
+            default:
+                break;
             }
         }
 ;
@@ -254,153 +176,105 @@ value_list:
     |   value_list ',' value
 ;
 value:
-        STRING { svalues.push($1); }
-    |   NUMBER { dvalues.push_back($1); }
+        STRING { ctx.svalues.push_back($1); }
+    |   NUMBER { ctx.dvalues.push_back($1); }
 ;
 group:
         STRING '(' ')' '{' statements '}' {
-            if (!strcmp($1, "leakage_power")) {
-            } else if (!strcmp($1, "timing")) {
-                opin.timings.push_back(timing);
-            } else if (!strcmp($1, "internal_power")) {
-            } else if (!strcmp($1, "output_current_fall")) {
-            } else if (!strcmp($1, "output_current_rise")) {
-            } else if (!strcmp($1, "receiver_capacitance")) {
-            } else {
-                cout <<"unknown group : " << $1 << endl;
+            if (LibertyContext::key($1) == LibertyKey::Timing) {
+                ctx.opin.timings.push_back(ctx.timing);
             }
         }
     |   STRING '(' STRING ')' '{' statements '}' {
-            if (!strcmp($1, "library")) {
-                stalib->name = $3;
-            } else if (!strcmp($1, "operating_conditions")) {
-            } else if (!strcmp($1, "wire_load")) {
-            } else if (!strcmp($1, "power_lut_template")) {
-                lut.clear();
-            } else if (!strcmp($1, "lu_table_template")) {
-                lutTemplate = $3;
-                lut.clear();
-            } else if(!strcmp($1, "cell")) {
-                cell.name($3);
-                unordered_map<string, CellType*>::iterator mi = database.name_celltypes.find(cell.name());
-                if (mi != database.name_celltypes.end()) {
-                    STALibraryCell& libcell = stalib->cells[mi->second->libcell()];
-                    libcell.drive_strength(cell.drive_strength());
-                    for (const STALibraryIPin& ipin : cell.ipins) {
-                        bool ipFound = false;
-                        for (STALibraryIPin& libipin : libcell.ipins) {
-                            if(ipin.name() == libipin.name()) {
-                                libipin = move(ipin);
-                                ipFound = true;
-                                if (libcell.name() == "BUF_X4" && libipin.name() == "A") {
-                                    STALibraryIPin::default_capacitance = libipin.capacitance;
-                                }
-                                break;
-                            }
-                        }
-                        if (!ipFound) {
-                            cerr << "input pin not found: " << ipin.name() << endl;
-                        }
-                    }
-                    for (const STALibraryOPin& opin : cell.opins) {
-                        //  cout << opin.name() << '\t' << opin.max_capacitance << endl;
-                        bool opFound = false;
-                        for (STALibraryOPin& libopin : libcell.opins) {
-                            if (opin.name() == libopin.name()) {
-                                libopin = move(opin);
-                                opFound = true;
-                                if (libcell.name() == "BUF_X4" && libopin.name() == "Z") {
-                                    STALibraryOPin::default_max_capacitance = libopin.max_capacitance;
-                                }
-                                break;
-                            }
-                        }
-                        if (!opFound) {
-                            cerr << cell.name() << "\toutput pin not found: " << opin.name() << '\t' << opin.max_capacitance << endl;
-                            assert(false);
-                        }
-                    }
-                } else {
-                    cout << "not found: " << $3 << endl;
-                }
-                cell.name("");
-                cell.ipins.clear();
-                cell.opins.clear();
-            } else if (!strcmp($1, "pg_pin")) {
-            } else if (!strcmp($1, "pin")) {
-                switch (pindir) {
+            switch (LibertyContext::key($1)) {
+            case LibertyKey::Library:
+                ctx.liberty.library = $3;
+                break;
+            case LibertyKey::PowerLutTemplate:
+                ctx.lut.clear();
+                break;
+            case LibertyKey::LuTableTemplate:
+                ctx.lutTemplate = $3;
+                ctx.lut.clear();
+                break;
+            case LibertyKey::Cell: {
+                //  the drive strength carries over to the next cell, as it always did
+                const unsigned driveStrength = ctx.cell.drive_strength();
+                ctx.cell.name(string($3));
+                ctx.liberty.cells.push_back(move(ctx.cell));
+                ctx.cell = STALibraryCell("", driveStrength);
+                break;
+            }
+            case LibertyKey::Pin:
+                switch (ctx.pindir) {
                 case 'i':
-                    ipin.name($3);
-                    cell.ipins.push_back(ipin);
+                    ctx.ipin.name(string($3));
+                    ctx.cell.ipins.push_back(ctx.ipin);
                     break;
                 case 'n':
                     break;
                 case 'o':
-                    opin.name($3);
-                    cell.opins.push_back(opin);
-                    //  cout << pindir << ' ' << opin.name() << endl;
+                    ctx.opin.name(string($3));
+                    ctx.cell.opins.push_back(ctx.opin);
                     break;
                 default:
-                    cout << "unknown pin type: " << pindir << endl;
+                    printlog(LOG_WARN, "%s:%u: unknown pin type: %c", ctx.file.c_str(), ctx.line, ctx.pindir);
                     break;
                 }
 
-                ipin.name("");
-                ipin.capacitance = 0.0;
-                opin.name("");
-                opin.min_capacitance = 0.0;
-                opin.max_capacitance = 0.0;
-                opin.timings.clear();
-                pindir = 'x';
-            } else if (!strcmp($1, "cell_fall")) {
-                if(strcmp($3, lutTemplate.c_str())==0){
-                    timing.delayFall = lut;
-                } else if (!strcmp($3, "scalar")) {
-                    timing.delayFall = STALibraryLUT(lut.values[0][0][0]);
+                ctx.ipin.name("");
+                ctx.ipin.capacitance = 0.0;
+                ctx.opin.name("");
+                ctx.opin.min_capacitance = 0.0;
+                ctx.opin.max_capacitance = 0.0;
+                ctx.opin.timings.clear();
+                ctx.pindir = 'x';
+                break;
+            case LibertyKey::CellFall:
+                if ($3 == ctx.lutTemplate) {
+                    ctx.timing.delayFall = ctx.lut;
+                } else if ($3 == "scalar") {
+                    ctx.timing.delayFall = STALibraryLUT(ctx.lut.values[0]);
                 }
-                lut.clear();
-            } else if (!strcmp($1, "cell_rise")) {
-                if(strcmp($3, lutTemplate.c_str())==0){
-                    timing.delayRise = lut;
-                } else if (!strcmp($3, "scalar")) {
-                    timing.delayRise = STALibraryLUT(lut.values[0][0][0]);
+                ctx.lut.clear();
+                break;
+            case LibertyKey::CellRise:
+                if ($3 == ctx.lutTemplate) {
+                    ctx.timing.delayRise = ctx.lut;
+                } else if ($3 == "scalar") {
+                    ctx.timing.delayRise = STALibraryLUT(ctx.lut.values[0]);
                 }
-                lut.clear();
-            } else if (!strcmp($1, "fall_transition")) {
-                if(strcmp($3, lutTemplate.c_str())==0){
-                    timing.slewFall = lut;
-                } else if (!strcmp($3, "scalar")) {
-                    timing.slewFall = STALibraryLUT(lut.values[0][0][0]);
+                ctx.lut.clear();
+                break;
+            case LibertyKey::FallTransition:
+                if ($3 == ctx.lutTemplate) {
+                    ctx.timing.slewFall = ctx.lut;
+                } else if ($3 == "scalar") {
+                    ctx.timing.slewFall = STALibraryLUT(ctx.lut.values[0]);
                 }
-                lut.clear();
-            } else if (!strcmp($1, "rise_transition")) {
-                if(strcmp($3, lutTemplate.c_str())==0){
-                    timing.slewRise = lut;
-                } else if(!strcmp($3, "scalar")) {
-                    timing.slewRise = STALibraryLUT(lut.values[0][0][0]);
+                ctx.lut.clear();
+                break;
+            case LibertyKey::RiseTransition:
+                if ($3 == ctx.lutTemplate) {
+                    ctx.timing.slewRise = ctx.lut;
+                } else if ($3 == "scalar") {
+                    ctx.timing.slewRise = STALibraryLUT(ctx.lut.values[0]);
                 }
-                lut.clear();
-            } else if (!strcmp($1, "fall_power")) {
-                lut.clear();
-            } else if (!strcmp($1, "rise_power")) {
-                lut.clear();
-            } else if (!strcmp($1, "rise_constraint")) {
-                lut.clear();
-            } else if (!strcmp($1, "fall_constraint")) {
-                lut.clear();
-            } else if (!strcmp($1, "output_current_template")) {
-            } else if (!strcmp($1, "receiver_capacitance1_fall")) {
-                lut.clear();
-            } else if (!strcmp($1, "receiver_capacitance1_rise")) {
-                lut.clear();
-            } else if (!strcmp($1, "receiver_capacitance2_fall")) {
-                lut.clear();
-            } else if (!strcmp($1, "receiver_capacitance2_rise")) {
-                lut.clear();
-            } else if (!strcmp($1, "vector")) {
-                lut.clear();
-            } else {
-                cout << "read group " << $1 << "() finish" << endl;
+                ctx.lut.clear();
+                break;
+            case LibertyKey::FallPower:
+            case LibertyKey::RisePower:
+            case LibertyKey::RiseConstraint:
+            case LibertyKey::FallConstraint:
+            case LibertyKey::ReceiverCapacitance1Fall:
+            case LibertyKey::ReceiverCapacitance1Rise:
+            case LibertyKey::ReceiverCapacitance2Fall:
+            case LibertyKey::ReceiverCapacitance2Rise:
+            case LibertyKey::Vector:
+                ctx.lut.clear();
+                break;
+            default:
+                break;
             }
         }
     |   STRING '(' value_list ')' '{' statements '}' {
@@ -410,34 +284,95 @@ group:
 
 %%
 
-void read_liberty(STALibrary *lib, const string& filename)
+bool io::parseLiberty(const string& file, LibertyCells& liberty)
 {
-    FILE *fp = fopen(filename.c_str(), "r");
-    if(!fp){
-        cerr<<"open file fail: "<<filename<<" : "
-            <<__FILE__<<":"<<__LINE__<<endl;
-        return;
+    MappedFile mapped;
+    if (!mapped.open(file)) {
+        printlog(LOG_ERROR, "Unable to open Liberty file: %s", file.c_str());
+        return false;
     }
-    yyin = fp;
-    stalib = lib;
-    while(!feof(yyin)){
-        yyparse();
+
+#ifndef NDEBUG
+    printlog(LOG_INFO, "reading %s", file.c_str());
+#endif
+
+    LibertyContext ctx(liberty, file, mapped.begin(), mapped.end());
+    if (yyparse(ctx) || ctx.failed) {
+        printlog(LOG_ERROR, "Error in reading Liberty");
+        return false;
     }
-    fclose(fp);
-    lib->postLoad();
+    return true;
 }
 
-bool Database::readLiberty(const string& filename)
+namespace {
+//  Bind the parsed cells of `file` to the LEF cell types: their library cells in `rlib`, the capacitances of their
+//  pin types and the default capacitances. Unlike the parse, this writes process-wide state and runs alone.
+void bindLiberty(Database& db, const LibertyCells& liberty, const string& file)
 {
-    read_liberty(&(rlib), filename);
-    return true;
+    STALibrary& lib = rlib;
+    lib.name = liberty.library;
+    lib.capacitanceUnit = liberty.capacitanceUnit;
+    unsigned nUnknownCells = 0;
+    for (const STALibraryCell& cell : liberty.cells) {
+        unordered_map<string, CellType*>::iterator mi = db.name_celltypes.find(cell.name());
+        if (mi == db.name_celltypes.end()) {
+            ++nUnknownCells;
+            continue;
+        }
+        STALibraryCell& libcell = lib.cells[mi->second->libcell()];
+        libcell.drive_strength(cell.drive_strength());
+        for (const STALibraryIPin& ipin : cell.ipins) {
+            bool ipFound = false;
+            for (STALibraryIPin& libipin : libcell.ipins) {
+                if (ipin.name() == libipin.name()) {
+                    libipin = ipin;
+                    ipFound = true;
+                    for (PinType* pintype : mi->second->pins) {
+                        if (pintype->name() == ipin.name()) pintype->capacitance(ipin.capacitance);
+                    }
+                    if (libcell.name() == "BUF_X4" && libipin.name() == "A") {
+                        STALibraryIPin::default_capacitance = libipin.capacitance;
+                    }
+                    break;
+                }
+            }
+            if (!ipFound) {
+                printlog(LOG_WARN, "%s input pin not found: %s", cell.name().c_str(), ipin.name().c_str());
+            }
+        }
+        for (const STALibraryOPin& opin : cell.opins) {
+            bool opFound = false;
+            for (STALibraryOPin& libopin : libcell.opins) {
+                if (opin.name() == libopin.name()) {
+                    libopin = opin;
+                    opFound = true;
+                    if (libcell.name() == "BUF_X4" && libopin.name() == "Z") {
+                        STALibraryOPin::default_max_capacitance = libopin.max_capacitance;
+                    }
+                    break;
+                }
+            }
+            if (!opFound) {
+                printlog(LOG_ERROR, "%s output pin not found: %s", cell.name().c_str(), opin.name().c_str());
+            }
+        }
+    }
+    if (nUnknownCells) {
+        printlog(LOG_WARN, "%u cells of %s are not in LEF", nUnknownCells, file.c_str());
+    }
+    lib.postLoad();
 }
+}  // namespace
 
-/*
-void read_liberty_benchmark(STATimer *timer)
+bool Database::readLiberty(const string& file)
 {
-    read_liberty(&(timer->lLib), setting.benchmark_dir+setting.lib_late);
-    read_liberty(&(timer->eLib), setting.benchmark_dir+setting.lib_early);
+    LibertyCells liberty;
+    const string cache = IOModule::LibertyCache.empty() ? "" : libertyCachePath(IOModule::LibertyCache, file);
+    if (cache.empty() || !readLibertyCache(cache, file, liberty)) {
+        liberty = LibertyCells();
+        if (!parseLiberty(file, liberty)) return false;
+        if (!cache.empty() && !IOModule::writeDir(IOModule::LibertyCache)) writeLibertyCache(cache, file, liberty);
+    }
+    bindLiberty(*this, liberty, file);
+    return true;
 }
-*/
-
@@ -0,0 +1,270 @@
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "file_liberty.h"
+#include "utils.h"
+using namespace io;
+using namespace sta;
+
+namespace {
+constexpr char Magic[8] = {'S', 'T', 'A', 'L', 'I', 'B', 'C', '\0'};
+//  bump whenever the layout below or the parsed content changes
+constexpr uint32_t Version = 3;
+constexpr uint32_t ByteOrder = 0x01020304;
+
+struct CacheHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t byteOrder;
+    uint64_t size;
+    int64_t mtime;
+    uint64_t hash;
+};
+
+uint64_t hashContent(const char* begin, const char* end) {
+    uint64_t h = 0x9e3779b97f4a7c15ull ^ static_cast<uint64_t>(end - begin);
+    const char* p = begin;
+    for (; end - p >= 8; p += 8) {
+        uint64_t word;
+        memcpy(&word, p, 8);
+        h = (h ^ word) * 0x100000001b3ull;
+        h ^= h >> 29;
+    }
+    for (; p != end; ++p) h = (h ^ static_cast<unsigned char>(*p)) * 0x100000001b3ull;
+    return h;
+}
+
+bool statFile(const string& file, uint64_t& size, int64_t& mtime) {
+    struct stat st;
+    if (stat(file.c_str(), &st)) return false;
+    size = st.st_size;
+    mtime = static_cast<int64_t>(st.st_mtim.tv_sec) * 1000000000 + st.st_mtim.tv_nsec;
+    return true;
+}
+
+bool hashFile(const string& file, uint64_t& hash) {
+    MappedFile mapped;
+    if (!mapped.open(file)) return false;
+    hash = hashContent(mapped.begin(), mapped.end());
+    return true;
+}
+
+class CacheWriter {
+private:
+    string _data;
+
+public:
+    template <typename T>
+    void pod(const T& value) {
+        _data.append(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+    void str(const string& s) {
+        pod<uint32_t>(s.size());
+        _data.append(s);
+    }
+    void doubles(const vector<double>& values) {
+        pod<uint32_t>(values.size());
+        _data.append(reinterpret_cast<const char*>(values.data()), values.size() * sizeof(double));
+    }
+    void lut(const STALibraryLUT& lut) {
+        pod<uint8_t>(lut.isScalar);
+        pod(lut.value);
+        doubles(lut.indexX);
+        doubles(lut.indexY);
+        doubles(lut.indexZ);
+        pod(lut.nx);
+        pod(lut.ny);
+        pod(lut.nz);
+        doubles(lut.values);
+    }
+
+    const string& data() const { return _data; }
+};
+
+//  bounds-checked reader, any overrun marks the cache as invalid
+class CacheReader {
+private:
+    const char* _p;
+    const char* const _end;
+    bool _ok = true;
+
+    bool has(const size_t size) {
+        if (static_cast<size_t>(_end - _p) < size) _ok = false;
+        return _ok;
+    }
+
+public:
+    CacheReader(const char* begin, const char* end) : _p(begin), _end(end) {}
+
+    bool ok() const { return _ok; }
+    bool done() const { return _ok && _p == _end; }
+
+    template <typename T>
+    T pod() {
+        T value{};
+        if (!has(sizeof(T))) return value;
+        memcpy(&value, _p, sizeof(T));
+        _p += sizeof(T);
+        return value;
+    }
+    string str() {
+        const uint32_t size = pod<uint32_t>();
+        if (!has(size)) return "";
+        string s(_p, size);
+        _p += size;
+        return s;
+    }
+    void doubles(vector<double>& values) {
+        const uint32_t size = pod<uint32_t>();
+        if (!has(static_cast<size_t>(size) * sizeof(double))) return;
+        values.resize(size);
+        memcpy(values.data(), _p, size * sizeof(double));
+        _p += size * sizeof(double);
+    }
+    void lut(STALibraryLUT& lut) {
+        lut.isScalar = pod<uint8_t>();
+        lut.value = pod<double>();
+        doubles(lut.indexX);
+        doubles(lut.indexY);
+        doubles(lut.indexZ);
+        const unsigned nx = pod<unsigned>();
+        const unsigned ny = pod<unsigned>();
+        const unsigned nz = pod<unsigned>();
+        vector<double> values;
+        doubles(values);
+        //  interpolation trusts the shape, so check it like the parser does
+        const auto fits = [](const unsigned n, const vector<double>& index) { return n <= 1 || n == index.size(); };
+        if (static_cast<size_t>(nx) * ny * nz != values.size() || !fits(nx, lut.indexX) || !fits(ny, lut.indexY) ||
+            !fits(nz, lut.indexZ)) {
+            _ok = false;
+            return;
+        }
+        lut.set(nx, ny, nz, move(values));
+    }
+};
+}  // namespace
+
+string io::libertyCachePath(const string& dir, const string& file) {
+    char* real = realpath(file.c_str(), nullptr);
+    const string path = real ? real : file;
+    free(real);
+    char key[17];
+    snprintf(key, sizeof(key), "%016llx", static_cast<unsigned long long>(hashContent(path.data(), path.data() + path.size())));
+    const size_t slash = path.find_last_of('/');
+    return dir + "/" + path.substr(slash == string::npos ? 0 : slash + 1) + "." + key + ".cache";
+}
+
+bool io::readLibertyCache(const string& cache, const string& file, LibertyCells& liberty) {
+    MappedFile mapped;
+    uint64_t size = 0;
+    int64_t mtime = 0;
+    if (!mapped.open(cache) || !statFile(file, size, mtime)) return false;
+
+    CacheHeader header;
+    if (mapped.size() < sizeof(header)) return false;
+    memcpy(&header, mapped.begin(), sizeof(header));
+    if (memcmp(header.magic, Magic, sizeof(Magic)) || header.version != Version || header.byteOrder != ByteOrder ||
+        header.size != size) {
+        return false;
+    }
+    if (header.mtime != mtime) {
+        //  touched or copied, still valid if the content is the same
+        uint64_t hash = 0;
+        if (!hashFile(file, hash) || hash != header.hash) return false;
+    }
+
+#ifndef NDEBUG
+    printlog(LOG_INFO, "reading %s", cache.c_str());
+#endif
+
+    CacheReader reader(mapped.begin() + sizeof(header), mapped.end());
+    liberty.library = reader.str();
+    liberty.capacitanceUnit = reader.pod<double>();
+    const uint32_t nCells = reader.pod<uint32_t>();
+    for (uint32_t c = 0; c < nCells && reader.ok(); ++c) {
+        const string name = reader.str();
+        liberty.cells.emplace_back(name, reader.pod<uint32_t>());
+        STALibraryCell& cell = liberty.cells.back();
+        const uint32_t nIPins = reader.pod<uint32_t>();
+        for (uint32_t i = 0; i < nIPins && reader.ok(); ++i) {
+            cell.ipins.emplace_back(reader.str());
+            cell.ipins.back().capacitance = reader.pod<double>();
+        }
+        const uint32_t nOPins = reader.pod<uint32_t>();
+        for (uint32_t o = 0; o < nOPins && reader.ok(); ++o) {
+            cell.opins.emplace_back(reader.str());
+            STALibraryOPin& opin = cell.opins.back();
+            opin.min_capacitance = reader.pod<double>();
+            opin.max_capacitance = reader.pod<double>();
+            const uint32_t nTimings = reader.pod<uint32_t>();
+            for (uint32_t t = 0; t < nTimings && reader.ok(); ++t) {
+                opin.timings.emplace_back();
+                STALibraryTiming& timing = opin.timings.back();
+                timing.relatedPinName = reader.str();
+                timing.timingSense = reader.pod<char>();
+                reader.lut(timing.delayRise);
+                reader.lut(timing.delayFall);
+                reader.lut(timing.slewRise);
+                reader.lut(timing.slewFall);
+            }
+        }
+    }
+    if (!reader.done()) {
+        printlog(LOG_WARN, "Ignoring corrupted Liberty cache: %s", cache.c_str());
+        return false;
+    }
+    return true;
+}
+
+bool io::writeLibertyCache(const string& cache, const string& file, const LibertyCells& liberty) {
+    CacheHeader header;
+    memcpy(header.magic, Magic, sizeof(Magic));
+    header.version = Version;
+    header.byteOrder = ByteOrder;
+    if (!statFile(file, header.size, header.mtime) || !hashFile(file, header.hash)) return false;
+
+    CacheWriter writer;
+    writer.pod(header);
+    writer.str(liberty.library);
+    writer.pod(liberty.capacitanceUnit);
+    writer.pod<uint32_t>(liberty.cells.size());
+    for (const STALibraryCell& cell : liberty.cells) {
+        writer.str(cell.name());
+        writer.pod<uint32_t>(cell.drive_strength());
+        writer.pod<uint32_t>(cell.ipins.size());
+        for (const STALibraryIPin& ipin : cell.ipins) {
+            writer.str(ipin.name());
+            writer.pod(ipin.capacitance);
+        }
+        writer.pod<uint32_t>(cell.opins.size());
+        for (const STALibraryOPin& opin : cell.opins) {
+            writer.str(opin.name());
+            writer.pod(opin.min_capacitance);
+            writer.pod(opin.max_capacitance);
+            writer.pod<uint32_t>(opin.timings.size());
+            for (const STALibraryTiming& timing : opin.timings) {
+                writer.str(timing.relatedPinName);
+                writer.pod(timing.timingSense);
+                writer.lut(timing.delayRise);
+                writer.lut(timing.delayFall);
+                writer.lut(timing.slewRise);
+                writer.lut(timing.slewFall);
+            }
+        }
+    }
+
+    //  write aside and rename, so that concurrent runs never map a partial cache
+    const string tmp = cache + "." + to_string(getpid());
+    FILE* fp = fopen(tmp.c_str(), "wb");
+    if (!fp) {
+        printlog(LOG_WARN, "Unable to write Liberty cache: %s", cache.c_str());
+        return false;
+    }
+    const bool written = fwrite(writer.data().data(), 1, writer.data().size(), fp) == writer.data().size();
+    if (fclose(fp) || !written || rename(tmp.c_str(), cache.c_str())) {
+        unlink(tmp.c_str());
+        printlog(LOG_WARN, "Unable to write Liberty cache: %s", cache.c_str());
+        return false;
+    }
+    return true;
+}
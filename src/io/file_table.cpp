@@ -0,0 +1,174 @@
+#include "file_table.h"
+
+#include <charconv>
+#include <cstring>
+
+namespace {
+const char Magic[] = "SXCOL001";
+
+template <typename T>
+void appendWords(std::string& out, const T* words, const size_t n) {
+    static_assert(sizeof(T) == 8, "columns are made of 8-byte words");
+    out.append(reinterpret_cast<const char*>(words), n * 8);
+}
+
+void appendWord(std::string& out, const unsigned long long word) { appendWords(out, &word, 1); }
+
+void pad(std::string& out) { out.resize((out.size() + 7) / 8 * 8, '\0'); }
+}  // namespace
+
+/***** RowGroup *****/
+
+io::RowGroup::RowGroup(const std::vector<ColumnSchema>& schema) : _chunks(schema.size()) {
+    for (const ColumnSchema& column : schema) _types.push_back(column.type);
+}
+
+void io::RowGroup::push(const unsigned col, ColumnValue&& value) {
+    Chunk& chunk = _chunks[col];
+    switch (_types[col]) {
+        case ColumnType::Int:
+            chunk.ints.push_back(std::get<long long>(value));
+            break;
+        case ColumnType::Double:
+            chunk.doubles.push_back(std::get<double>(value));
+            break;
+        case ColumnType::String:
+            chunk.chars += std::get<std::string>(value);
+            chunk.ends.push_back(chunk.chars.size());
+            break;
+    }
+}
+
+void io::RowGroup::append(const RowGroup& rows) {
+    for (unsigned c = 0; c != _chunks.size(); ++c) {
+        Chunk& chunk = _chunks[c];
+        const Chunk& other = rows._chunks[c];
+        chunk.ints.insert(chunk.ints.end(), other.ints.begin(), other.ints.end());
+        chunk.doubles.insert(chunk.doubles.end(), other.doubles.begin(), other.doubles.end());
+        const size_t base = chunk.chars.size();
+        chunk.chars += other.chars;
+        for (const unsigned long long end : other.ends) chunk.ends.push_back(base + end);
+    }
+    _nRows += rows._nRows;
+}
+
+void io::RowGroup::clear() {
+    for (Chunk& chunk : _chunks) chunk = Chunk();
+    _nRows = 0;
+}
+
+void io::RowGroup::csv(std::string& out) const {
+    char buffer[32];
+    for (unsigned r = 0; r != _nRows; ++r) {
+        for (unsigned c = 0; c != _chunks.size(); ++c) {
+            if (c) out += ',';
+            const Chunk& chunk = _chunks[c];
+            switch (_types[c]) {
+                case ColumnType::Int:
+                    out.append(buffer, std::to_chars(buffer, buffer + sizeof(buffer), chunk.ints[r]).ptr);
+                    break;
+                case ColumnType::Double:
+                    //  as printed by ostream
+                    out.append(buffer, snprintf(buffer, sizeof(buffer), "%g", chunk.doubles[r]));
+                    break;
+                case ColumnType::String: {
+                    const size_t begin = r ? chunk.ends[r - 1] : 0;
+                    out.append(chunk.chars, begin, chunk.ends[r] - begin);
+                    break;
+                }
+            }
+        }
+        out += '\n';
+    }
+}
+
+void io::RowGroup::columnar(std::string& out) const {
+    appendWord(out, _nRows);
+    for (unsigned c = 0; c != _chunks.size(); ++c) {
+        const Chunk& chunk = _chunks[c];
+        switch (_types[c]) {
+            case ColumnType::Int:
+                appendWords(out, chunk.ints.data(), _nRows);
+                break;
+            case ColumnType::Double:
+                appendWords(out, chunk.doubles.data(), _nRows);
+                break;
+            case ColumnType::String:
+                appendWord(out, 0);
+                appendWords(out, chunk.ends.data(), _nRows);
+                out += chunk.chars;
+                pad(out);
+                break;
+        }
+    }
+}
+
+/***** TableFile *****/
+
+io::TableFile::TableFile(AsyncWriter& writer,
+                         const std::string& file,
+                         const std::vector<ColumnSchema>& schema,
+                         const bool columnar,
+                         const unsigned groupSize)
+    : _writer(writer), _file(file), _columnar(columnar), _groupSize(groupSize), _rows(schema) {
+    std::string header;
+    if (_columnar) {
+        header.append(Magic, 8);
+        appendWord(header, schema.size());
+        for (const ColumnSchema& column : schema) {
+            appendWord(header, static_cast<unsigned long long>(column.type));
+            appendWord(header, column.name.size());
+            header += column.name;
+            pad(header);
+        }
+    } else {
+        for (unsigned c = 0; c != schema.size(); ++c) {
+            if (c) header += ',';
+            header += schema[c].name;
+        }
+        header += '\n';
+    }
+    write(std::move(header));
+}
+
+void io::TableFile::write(std::string&& data) {
+    _offset += data.size();
+    _writer.append(_file, std::move(data));
+}
+
+void io::TableFile::writeRows() {
+    if (!_rows.size()) return;
+    std::string data;
+    if (_columnar) {
+        _groupOffsets.push_back(_offset);
+        _rows.columnar(data);
+    } else {
+        _rows.csv(data);
+    }
+    _nRows += _rows.size();
+    _rows.clear();
+    write(std::move(data));
+}
+
+void io::TableFile::append(const RowGroup& rows) {
+    _rows.append(rows);
+    flush();
+}
+
+void io::TableFile::flush() {
+    if (_rows.size() >= _groupSize) writeRows();
+}
+
+void io::TableFile::close() {
+    if (_closed) return;
+    writeRows();
+    if (_columnar) {
+        std::string footer;
+        appendWords(footer, _groupOffsets.data(), _groupOffsets.size());
+        appendWord(footer, _groupOffsets.size());
+        appendWord(footer, _nRows);
+        footer.append(Magic, 8);
+        write(std::move(footer));
+    }
+    _closed = true;
+}
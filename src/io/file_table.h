@@ -0,0 +1,91 @@
+#ifndef _IO_FILE_TABLE_H_
+#define _IO_FILE_TABLE_H_
+
+#include <string>
+#include <variant>
+#include <vector>
+
+#include "utils.h"
+
+namespace io {
+enum class ColumnType : unsigned char { Int, Double, String };
+using ColumnValue = std::variant<long long, double, std::string>;
+
+struct ColumnSchema {
+    std::string name;
+    ColumnType type;
+};
+
+//  Rows of a table, buffered by column
+class RowGroup {
+private:
+    struct Chunk {
+        std::vector<long long> ints;
+        std::vector<double> doubles;
+        std::string chars;
+        //  the end of each string in `chars`
+        std::vector<unsigned long long> ends;
+    };
+
+    std::vector<ColumnType> _types;
+    std::vector<Chunk> _chunks;
+    unsigned _nRows = 0;
+
+public:
+    RowGroup(const std::vector<ColumnSchema>& schema);
+
+    //  the value of the next column of the current row
+    void push(const unsigned col, ColumnValue&& value);
+    void endRow() { ++_nRows; }
+    void append(const RowGroup& rows);
+    void clear();
+
+    unsigned size() const { return _nRows; }
+
+    void csv(std::string& out) const;
+    void columnar(std::string& out) const;
+};
+
+//  A table streamed to an AsyncWriter in row groups, either as CSV or in a columnar binary format.
+//  The columnar file is made of 8-byte aligned little-endian words, so that a reader can map it and use the
+//  columns in place:
+//      header      "SXCOL001", #columns, then per column: type (0 int64, 1 float64, 2 string), name length,
+//                  and the name padded to 8 bytes
+//      row group   #rows, then per column: the int64 or float64 values, or for strings the #rows + 1 offsets
+//                  into their bytes and the bytes padded to 8
+//      footer      the offset of each row group, #row groups, #rows, "SXCOL001"
+class TableFile {
+private:
+    AsyncWriter& _writer;
+    const std::string _file;
+    const bool _columnar;
+    const unsigned _groupSize;
+    RowGroup _rows;
+    size_t _offset = 0;
+    std::vector<unsigned long long> _groupOffsets;
+    unsigned long long _nRows = 0;
+    bool _closed = false;
+
+    void write(std::string&& data);
+    void writeRows();
+
+public:
+    TableFile(AsyncWriter& writer,
+              const std::string& file,
+              const std::vector<ColumnSchema>& schema,
+              const bool columnar,
+              const unsigned groupSize = 1 << 16);
+    TableFile(const TableFile&) = delete;
+    TableFile& operator=(const TableFile&) = delete;
+    ~TableFile() { close(); }
+
+    //  the rows waiting to be written, add to them and `flush`
+    RowGroup& rows() { return _rows; }
+    void append(const RowGroup& rows);
+    //  write the rows once they fill a row group
+    void flush();
+    void close();
+};
+}  // namespace io
+
+#endif
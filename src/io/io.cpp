@@ -1,5 +1,7 @@
 #include "io.h"
 #include <sys/stat.h>
+#include <mutex>
+#include <unordered_set>
 #include "../db/db.h"
 #include "../global.h"
 
@@ -21,6 +23,13 @@ std::string IOModule::DefCell = "";
 std::string IOModule::DefPlacement = "";
 
 std::string io::IOModule::Liberty = "";
+std::string io::IOModule::LibertyCache = "";
+std::string io::IOModule::ImageDir = "";
+unsigned io::IOModule::ImageShards = 0;
+std::vector<std::string> io::IOModule::Columns;
+bool io::IOModule::Columnar = false;
+bool io::IOModule::GraphTables = false;
+std::map<std::string, std::string>* io::IOModule::Capture = nullptr;
 
 std::string io::IOModule::NetDetail = "";
 std::string io::IOModule::TimePath = "";
@@ -38,32 +47,69 @@ void IOModule::showOptions() const {
     printlog(LOG_INFO, "defCell             : %s", IOModule::DefCell.c_str());
     printlog(LOG_INFO, "defPlacement        : %s", IOModule::DefPlacement.c_str());
     printlog(LOG_INFO, "liberty             : %s", IOModule::Liberty.c_str());
+    printlog(LOG_INFO, "libertyCache        : %s", IOModule::LibertyCache.c_str());
+    printlog(LOG_INFO, "imageDir            : %s", IOModule::ImageDir.c_str());
+    printlog(LOG_INFO, "imageShards         : %u", IOModule::ImageShards);
+    printlog(LOG_INFO, "columns             : %lu", IOModule::Columns.size());
+    printlog(LOG_INFO, "columnar            : %d", IOModule::Columnar);
+    printlog(LOG_INFO, "graphTables         : %d", IOModule::GraphTables);
     printlog(LOG_INFO, "netDetail           : %s", IOModule::NetDetail.c_str());
 }
 
 bool io::IOModule::load() {
+    bool ok = true;
     if (BookshelfAux.length() > 0 && BookshelfPl.length()) {
         Format = "bookshelf";
-        database.readBSAux(BookshelfAux, BookshelfPl);
+        ok = database.readBSAux(BookshelfAux, BookshelfPl) && ok;
     }
     if (LefTech.length()) {
         Format = "lefdef";
-        database.readLEF(LefTech);
+        ok = database.readLEF(LefTech) && ok;
     }
     if (LefCell.length()) {
         Format = "lefdef";
-        database.readLEF(LefCell);
+        ok = database.readLEF(LefCell) && ok;
     }
     if (DefCell.length()) {
         Format = "lefdef";
-        database.readDEF(DefCell);
-    } else if (DefFloorplan.length()) database.readDEF(DefFloorplan);
+        ok = database.readDEF(DefCell) && ok;
+    } else if (DefFloorplan.length()) ok = database.readDEF(DefFloorplan) && ok;
 
-    if (Liberty.length()) database.readLiberty(Liberty);
+    if (Liberty.length()) ok = database.readLiberty(Liberty) && ok;
+    return ok;
+}
+
+bool io::IOModule::selectColumns(const string& spec) {
+    string names = spec;
+    std::ifstream ifs(spec);
+    if (ifs.good()) {
+        std::ostringstream oss;
+        oss << ifs.rdbuf();
+        names = oss.str();
+    }
+    std::replace(names.begin(), names.end(), ',', ' ');
+    std::istringstream iss(names);
+    Columns.clear();
+    for (string name; iss >> name;) Columns.push_back(name);
+    if (Columns.empty()) {
+        printlog(LOG_ERROR, "no columns in %s", spec.c_str());
+        return false;
+    }
     return true;
 }
 
+namespace {
+//  directories known to exist, so that each is created once per extraction
+std::mutex dirMtx;
+std::unordered_set<std::string> dirs;
+}  // namespace
+
 int io::IOModule::writeDir(const string& file) {
+    {
+        std::lock_guard<std::mutex> lock(dirMtx);
+        if (dirs.count(file)) return 0;
+    }
+
     size_t pos0 = file.find_last_of('/');
     if (pos0 != string::npos) {
         writeDir(file.substr(0, pos0));
@@ -80,15 +126,37 @@ int io::IOModule::writeDir(const string& file) {
                          file.c_str());
                 return ENOENT;
             case EEXIST:
-                return 0;
+                break;
             default:
                 printlog(LOG_ERROR, "mkdir failed on %s with error number: %d", file.c_str(), errno);
                 return errno;
         }
     }
+    std::lock_guard<std::mutex> lock(dirMtx);
+    dirs.insert(file);
     return 0;
 }
 
+void io::IOModule::forgetDirs() {
+    std::lock_guard<std::mutex> lock(dirMtx);
+    dirs.clear();
+}
+
+std::string io::IOModule::outputDir(const string& file) {
+    const size_t slash = file.find_last_of('/');
+    const string dir = slash == string::npos ? "." : file.substr(0, slash);
+    const string name = slash == string::npos ? file : file.substr(slash + 1);
+    return dir + "/" + name.substr(0, name.find('.'));
+}
+
+std::string io::IOModule::imageShard(const unsigned shard) {
+    int width = 1;
+    for (unsigned n = ImageShards - 1; n >= 16; n /= 16) ++width;
+    char name[16];
+    snprintf(name, sizeof(name), "%0*x", width, shard);
+    return name;
+}
+
 ofstream io::IOModule::write(const string& file, const bool verbose) {
     size_t pos0 = file.find_last_of('/');
     if (pos0 != string::npos) {
@@ -1,7 +1,9 @@
 #ifndef _IO_IO_H_
 #define _IO_IO_H_
 
+#include <map>
 #include <string>
+#include <vector>
 
 namespace io {
 class IOModule {
@@ -29,6 +31,19 @@ public:
     static std::string DefPlacement;
 
     static std::string Liberty;
+    static std::string LibertyCache;
+    static std::string ImageDir;
+    //  the number of subdirectories the via patches are spread over, 0 for none
+    static unsigned ImageShards;
+
+    //  the columns of the driver, sink and arc tables to write, all of them when empty
+    static std::vector<std::string> Columns;
+    //  the tables in the columnar binary format of io::TableFile instead of CSV
+    static bool Columnar;
+    //  also write the candidate graph as tables of split nets and arcs
+    static bool GraphTables;
+    //  where the outputs are kept by path instead of written, when set
+    static std::map<std::string, std::string>* Capture;
 
     static std::string NetDetail;
     static std::string TimePath;
@@ -38,7 +53,18 @@ public:
     const std::string& name() const { return _name; }
     static bool load();
 
+    //  a comma or whitespace separated list of columns, or a file of them
+    static bool selectColumns(const std::string& spec);
     static int writeDir(const std::string& file);
+    //  forget the directories created so far, which may have been removed since, before each extraction
+    static void forgetDirs();
+    //  the directory of the outputs named after `file`, <directory of file>/<name of file up to its first dot>
+    static std::string outputDir(const std::string& file);
+    //  the subdirectory of a shard of the via patches, named in hex digits wide enough for all the shards
+    static std::string imageShard(const unsigned shard);
+    static std::string imageShard(const std::string& stem) {
+        return imageShard(std::hash<std::string>()(stem) % ImageShards);
+    }
     static std::ofstream write(const std::string& file, const bool verbose = false);
 };
 }  // namespace io
@@ -1,5 +1,20 @@
 #include "utils.h"
 
+#include <algorithm>
+#include <errno.h>
+#include <functional>
+#include <unordered_map>
+#include <fcntl.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <zlib.h>
+
+#include "../ut/log.h"
+
 bool getInputStream(std::string &file, std::ifstream *ifs){
     ifs = new std::ifstream(file.c_str());
     return true;
@@ -8,3 +23,359 @@ bool getInputStream(std::string &file, std::ifstream *ifs){
 bool getOutputStream(std::string &file, std::ofstream &ofs){
     return true;
 }
+
+/***** MappedFile *****/
+
+bool io::MappedFile::open(const std::string& file) {
+    close();
+    const int fd = ::open(file.c_str(), O_RDONLY);
+    if (fd < 0) return false;
+    struct stat st;
+    if (fstat(fd, &st) || !S_ISREG(st.st_mode)) {
+        ::close(fd);
+        return false;
+    }
+    _size = st.st_size;
+    if (_size) {
+        void* data = mmap(nullptr, _size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (data == MAP_FAILED) {
+            ::close(fd);
+            _size = 0;
+            return false;
+        }
+        madvise(data, _size, MADV_WILLNEED);
+        _data = static_cast<const char*>(data);
+    }
+    //  the mapping stays valid after the descriptor is closed
+    ::close(fd);
+    _open = true;
+    return true;
+}
+
+void io::MappedFile::close() {
+    if (_data) munmap(const_cast<char*>(_data), _size);
+    _data = nullptr;
+    _size = 0;
+    _open = false;
+}
+
+/***** ScratchMemory *****/
+
+bool io::ScratchMemory::allocate(const size_t size, const std::string& dir) {
+    release();
+    if (!size) return true;
+    int flags = MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE;
+    if (dir.size()) {
+        std::string path = dir + "/scratch.XXXXXX";
+        _fd = mkstemp(&path[0]);
+        if (_fd < 0) {
+            printlog(LOG_ERROR, "cannot create scratch file in %s", dir.c_str());
+            return false;
+        }
+        //  nothing but the mapping refers to it
+        unlink(path.c_str());
+        if (ftruncate(_fd, size)) {
+            printlog(LOG_ERROR, "cannot size scratch file in %s to %lu bytes", dir.c_str(), size);
+            release();
+            return false;
+        }
+        flags = MAP_SHARED;
+    }
+    void* data = mmap(nullptr, size, PROT_READ | PROT_WRITE, flags, _fd, 0);
+    if (data == MAP_FAILED) {
+        printlog(LOG_ERROR, "cannot map %lu bytes of scratch memory", size);
+        release();
+        return false;
+    }
+    _data = static_cast<char*>(data);
+    _size = size;
+    return true;
+}
+
+void io::ScratchMemory::release() {
+    if (_data) munmap(_data, _size);
+    if (_fd >= 0) ::close(_fd);
+    _data = nullptr;
+    _size = 0;
+    _fd = -1;
+}
+
+void io::ScratchMemory::evict(const size_t offset, const size_t size) {
+    //  dropping anonymous pages would zero them
+    if (_fd < 0) return;
+    madvise(_data + offset, size, MADV_DONTNEED);
+    posix_fadvise(_fd, offset, size, POSIX_FADV_DONTNEED);
+}
+
+/***** AsyncWriter *****/
+
+io::AsyncWriter::AsyncWriter(const unsigned nThreads, const size_t capacity)
+    : _capacity(capacity), _queues(std::max(nThreads, 1u)) {
+    for (Queue& queue : _queues) queue.thread = std::thread(&AsyncWriter::serve, this, std::ref(queue));
+}
+
+io::AsyncWriter::~AsyncWriter() {
+    {
+        std::lock_guard<std::mutex> lock(_mtx);
+        _stop = true;
+    }
+    for (Queue& queue : _queues) {
+        queue.ready.notify_one();
+        queue.thread.join();
+    }
+}
+
+void io::AsyncWriter::push(Job&& job) {
+    Queue& queue = _queues[std::hash<std::string>()(job.file) % _queues.size()];
+    push(std::move(job), queue);
+}
+
+void io::AsyncWriter::push(Job&& job, Queue& queue) {
+    std::unique_lock<std::mutex> lock(_mtx);
+    //  a job larger than the capacity still goes through alone
+    _drained.wait(lock, [&] { return !_nPendingBytes || _nPendingBytes + job.data.size() <= _capacity; });
+    ++_nPending;
+    _nPendingBytes += job.data.size();
+    queue.jobs.push_back(std::move(job));
+    queue.ready.notify_one();
+}
+
+bool io::AsyncWriter::flush() {
+    //  an empty append closes the files of each thread once their jobs are done
+    for (Queue& queue : _queues) push({"", "", JobKind::Append}, queue);
+    std::unique_lock<std::mutex> lock(_mtx);
+    _drained.wait(lock, [&] { return !_nPending; });
+    const bool good = _good;
+    _good = true;
+    return good;
+}
+
+namespace {
+bool writeAll(const int fd, const std::string& data) {
+    for (size_t written = 0; written != data.size();) {
+        const ssize_t n = ::write(fd, data.data() + written, data.size() - written);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            return false;
+        }
+        written += n;
+    }
+    return true;
+}
+}  // namespace
+
+bool io::AsyncWriter::writeFile(const Job& job) {
+    if (_files) {
+        std::lock_guard<std::mutex> lock(_filesMtx);
+        (*_files)[job.file] = job.data;
+        return true;
+    }
+    const int fd = ::open(job.file.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0666);
+    if (fd < 0) return false;
+    const bool written = writeAll(fd, job.data);
+    return !::close(fd) && written;
+}
+
+bool io::AsyncWriter::linkFile(const Job& job) {
+    const std::string& file = job.data;
+    if (_files) {
+        std::lock_guard<std::mutex> lock(_filesMtx);
+        const std::map<std::string, std::string>::const_iterator fi = _files->find(file);
+        if (fi == _files->end()) return false;
+        (*_files)[job.file] = fi->second;
+        return true;
+    }
+    unlink(job.file.c_str());
+    if (!::link(file.c_str(), job.file.c_str())) return true;
+    //  without hard links, copy
+    std::ifstream ifs(file, std::ios::binary);
+    std::ofstream ofs(job.file, std::ios::binary);
+    ofs << ifs.rdbuf();
+    return ofs.good();
+}
+
+void io::AsyncWriter::serve(Queue& queue) {
+    //  appended files stay open until the next flush and are reopened after it at their end, closed and captured ones
+    //  have no descriptor
+    std::unordered_map<std::string, int> fds;
+    std::deque<Job> jobs;
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(_mtx);
+            queue.ready.wait(lock, [&] { return _stop || queue.jobs.size(); });
+            if (queue.jobs.empty()) break;
+            jobs.swap(queue.jobs);
+        }
+        size_t nBytes = 0;
+        bool good = true;
+        for (const Job& job : jobs) {
+            nBytes += job.data.size();
+            if (job.file.empty()) {
+                for (auto& [file, fd] : fds) {
+                    if (fd >= 0 && ::close(fd)) {
+                        printlog(LOG_ERROR, "cannot write %s", file.c_str());
+                        good = false;
+                    }
+                    fd = -1;
+                }
+                continue;
+            }
+            bool written = false;
+            if (job.kind == JobKind::Link) {
+                written = linkFile(job);
+            } else if (job.kind == JobKind::Write) {
+                written = writeFile(job);
+            } else if (_files) {
+                const bool truncate = fds.emplace(job.file, -1).second;
+                std::lock_guard<std::mutex> lock(_filesMtx);
+                std::string& data = (*_files)[job.file];
+                if (truncate) data.clear();
+                data += job.data;
+                written = true;
+            } else {
+                std::unordered_map<std::string, int>::iterator fi = fds.find(job.file);
+                if (fi == fds.end()) {
+                    const int fd = ::open(job.file.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0666);
+                    if (fd >= 0) fi = fds.emplace(job.file, fd).first;
+                } else if (fi->second < 0) {
+                    fi->second = ::open(job.file.c_str(), O_WRONLY | O_APPEND);
+                }
+                written = fi != fds.end() && fi->second >= 0 && writeAll(fi->second, job.data);
+            }
+            if (!written) {
+                printlog(LOG_ERROR, "cannot write %s", job.file.c_str());
+                good = false;
+            }
+        }
+        {
+            std::lock_guard<std::mutex> lock(_mtx);
+            _nPending -= jobs.size();
+            _nPendingBytes -= nBytes;
+            _good = _good && good;
+        }
+        _drained.notify_all();
+        jobs.clear();
+    }
+    for (const auto& [file, fd] : fds) {
+        if (fd >= 0) ::close(fd);
+    }
+}
+
+std::string io::manifest(std::vector<std::string>& files) {
+    std::sort(files.begin(), files.end());
+    std::string lines;
+    for (const std::string& file : files) lines.append(file).push_back('\n');
+    return lines;
+}
+
+/***** InputFile *****/
+
+namespace {
+bool endsWith(const std::string& str, const char* suffix) {
+    const size_t len = strlen(suffix);
+    return str.size() >= len && !str.compare(str.size() - len, len, suffix);
+}
+
+//  copy the inflated content of `gz` into the socket `fd` until the reader hangs up, `failed` on a corrupt or
+//  truncated file
+void inflateTo(gzFile gz, const int fd, const std::string file, bool& failed) {
+    std::vector<char> buffer(1 << 17);
+    int size = 0;
+    bool hungUp = false;
+    while (!hungUp && (size = gzread(gz, buffer.data(), buffer.size())) > 0) {
+        for (int sent = 0; sent < size;) {
+            const ssize_t n = send(fd, buffer.data() + sent, size - sent, MSG_NOSIGNAL);
+            if (n < 0) {
+                hungUp = true;
+                break;
+            }
+            sent += n;
+        }
+    }
+    //  a truncated file ends with gzread returning 0 and the error left in gzerror
+    int err = Z_OK;
+    const char* message = gzerror(gz, &err);
+    if (!hungUp && (size < 0 || err != Z_OK)) {
+        printlog(LOG_ERROR, "Error in decompressing %s: %s", file.c_str(), message);
+        failed = true;
+    }
+    gzclose(gz);
+    ::close(fd);
+}
+}  // namespace
+
+bool io::InputFile::isCompressed(const std::string& file) { return endsWith(file, ".gz") || endsWith(file, ".zst"); }
+
+bool io::InputFile::open(const std::string& file) {
+    close();
+    _file = file;
+    if (endsWith(file, ".zst")) {
+        if (access(file.c_str(), R_OK)) return false;
+        std::string quoted = "'";
+        for (const char c : file) {
+            quoted += c == '\'' ? std::string("'\\''") : std::string(1, c);
+        }
+        quoted += "'";
+        _fp = popen(("zstd -dcq -- " + quoted).c_str(), "r");
+        _popen = _fp;
+        return _fp;
+    }
+    if (!endsWith(file, ".gz")) {
+        _fp = fopen(file.c_str(), "r");
+        return _fp;
+    }
+
+    gzFile gz = gzopen(file.c_str(), "rb");
+    if (!gz) return false;
+    gzbuffer(gz, 1 << 17);
+    int fds[2];
+    if (socketpair(AF_UNIX, SOCK_STREAM, 0, fds)) {
+        gzclose(gz);
+        return false;
+    }
+    _fp = fdopen(fds[0], "r");
+    if (!_fp) {
+        ::close(fds[0]);
+        ::close(fds[1]);
+        gzclose(gz);
+        return false;
+    }
+    _inflater = std::thread(inflateTo, gz, fds[1], file, std::ref(_inflateFailed));
+    return true;
+}
+
+bool io::InputFile::close() {
+    bool ok = true;
+    if (_popen) {
+        //  the rest of the stream, so that zstd exits on its own
+        char buffer[1 << 12];
+        while (fread(buffer, 1, sizeof(buffer), _fp)) {
+        }
+        const int status = pclose(_fp);
+        if (status == -1 || !WIFEXITED(status) || WEXITSTATUS(status)) {
+            printlog(LOG_ERROR, "Error in decompressing %s", _file.c_str());
+            ok = false;
+        }
+    } else if (_fp) {
+        //  closing the read end stops an unfinished inflater
+        fclose(_fp);
+    }
+    if (_inflater.joinable()) _inflater.join();
+    ok = ok && !_inflateFailed;
+    _fp = nullptr;
+    _popen = false;
+    _inflateFailed = false;
+    return ok;
+}
+
+std::vector<const char*> io::splitLines(const char* begin, const char* end, const unsigned n) {
+    std::vector<const char*> bounds{begin};
+    for (unsigned i = 1; i < n; ++i) {
+        const char* p = std::max(begin + (end - begin) / n * i, bounds.back());
+        p = static_cast<const char*>(memchr(p, '\n', end - p));
+        if (!p) break;
+        if (++p != bounds.back()) bounds.push_back(p);
+    }
+    if (bounds.back() != end) bounds.push_back(end);
+    return bounds;
+}
@@ -3,11 +3,155 @@
 
 #include <string>
 #include <vector>
+#include <condition_variable>
+#include <cstdio>
+#include <deque>
 #include <fstream>
+#include <map>
+#include <mutex>
+#include <thread>
 
 bool getInputStream(std::string &file, std::ifstream &ifs);
 bool getOutputStream(std::string &file, std::ofstream &ofs);
 bool getTokens(std::string &str, std::vector<std::string> &token);
 
+namespace io {
+//  Read-only memory mapping of a whole file
+class MappedFile {
+private:
+    const char* _data = nullptr;
+    size_t _size = 0;
+    bool _open = false;
+
+public:
+    MappedFile() {}
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    ~MappedFile() { close(); }
+
+    bool open(const std::string& file);
+    void close();
+
+    bool isOpen() const { return _open; }
+    const char* begin() const { return _data; }
+    const char* end() const { return _data + _size; }
+    size_t size() const { return _size; }
+};
+
+//  Zero-filled scratch memory whose pages are only allocated when first touched.
+//  With a directory it is a shared mapping of an unlinked sparse file there, so that the kernel can write it back
+//  and reclaim it under memory pressure; otherwise it is anonymous memory.
+class ScratchMemory {
+private:
+    char* _data = nullptr;
+    size_t _size = 0;
+    int _fd = -1;
+
+public:
+    ScratchMemory() {}
+    ScratchMemory(const ScratchMemory&) = delete;
+    ScratchMemory& operator=(const ScratchMemory&) = delete;
+    ~ScratchMemory() { release(); }
+
+    bool allocate(const size_t size, const std::string& dir = "");
+    void release();
+    //  drop the resident pages of [offset, offset + size), which file-backed memory reads back when touched again
+    void evict(const size_t offset, const size_t size);
+
+    bool isFileBacked() const { return _fd >= 0; }
+    char* data() const { return _data; }
+    size_t size() const { return _size; }
+};
+
+//  Sequential input that transparently decompresses ".gz" and ".zst" files.
+//  Decompression runs on its own thread (or process for zstd) and feeds `fp()` through a socket pair,
+//  so it overlaps with the parser reading the stream and never touches the disk.
+//  Errors in decompressing, as a truncated file, are reported by `close`.
+class InputFile {
+private:
+    FILE* _fp = nullptr;
+    bool _popen = false;
+    std::string _file;
+    std::thread _inflater;
+    //  set by the inflater, read once it is joined
+    bool _inflateFailed = false;
+
+public:
+    InputFile() {}
+    InputFile(const InputFile&) = delete;
+    InputFile& operator=(const InputFile&) = delete;
+    ~InputFile() { close(); }
+
+    static bool isCompressed(const std::string& file);
+
+    bool open(const std::string& file);
+    //  false if the file could not be decompressed
+    bool close();
+
+    FILE* fp() const { return _fp; }
+};
+
+//  Writes files on background threads, so that the threads computing the output never wait on the file system.
+//  Jobs on the same file are written in order by the same thread, which takes all the jobs it has queued at once;
+//  `write` and `append` block while more than `capacity` bytes are waiting, which caps the memory in flight.
+//  Once `captureTo` a map, the files are kept there by path instead of written.
+class AsyncWriter {
+private:
+    enum class JobKind : unsigned char { Write, Append, Link };
+    struct Job {
+        std::string file;
+        //  the path of the linked file for links
+        std::string data;
+        JobKind kind;
+    };
+    struct Queue {
+        std::deque<Job> jobs;
+        std::condition_variable ready;
+        std::thread thread;
+    };
+
+    const size_t _capacity;
+    std::vector<Queue> _queues;
+    std::mutex _mtx;
+    std::condition_variable _drained;
+    size_t _nPending = 0;
+    size_t _nPendingBytes = 0;
+    bool _stop = false;
+    bool _good = true;
+    std::map<std::string, std::string>* _files = nullptr;
+    std::mutex _filesMtx;
+
+    void push(Job&& job);
+    void push(Job&& job, Queue& queue);
+    void serve(Queue& queue);
+    bool writeFile(const Job& job);
+    bool linkFile(const Job& job);
+
+public:
+    AsyncWriter(const unsigned nThreads = 2, const size_t capacity = 256 << 20);
+    AsyncWriter(const AsyncWriter&) = delete;
+    AsyncWriter& operator=(const AsyncWriter&) = delete;
+    ~AsyncWriter();
+
+    //  replace `file` with `data`
+    void write(const std::string& file, std::string&& data) { push({file, std::move(data), JobKind::Write}); }
+    //  add `data` to the end of `file`, which is truncated by its first append to this writer, even across flushes
+    void append(const std::string& file, std::string&& data) { push({file, std::move(data), JobKind::Append}); }
+    //  replace `link` with a hard link to `file`, or a copy of it where there are none; `file` must be flushed
+    void link(const std::string& file, const std::string& link) { push({link, file, JobKind::Link}); }
+    //  call before any job
+    void captureTo(std::map<std::string, std::string>* files) { _files = files; }
+    bool isCapturing() const { return _files; }
+    //  wait for all the jobs so far and close the appended files until their next append, false if any of them failed
+    bool flush();
+};
+
+//  The sorted lines of `files`
+std::string manifest(std::vector<std::string>& files);
+
+//  Split [begin, end) into at most `n` chunks of whole lines, returned as the n + 1 chunk bounds
+std::vector<const char*> splitLines(const char* begin, const char* end, const unsigned n);
+}  // namespace io
+
 #endif
 
@@ -1,5 +1,6 @@
 #include <args/args.hxx>
 
+#include "api/server.h"
 #include "db/db.h"
 #include "global.h"
 #include "io/io.h"
@@ -15,14 +16,28 @@ int main(int argc, char** argv) {
     args::ValueFlag<string> flow(parser, "flow", "The flow flag", {'f', "flow"});
     args::ValueFlag<string> input(parser, "input", "The input def flag", {'i', "input_def"});
     args::ValueFlag<string> liberty(parser, "liberty", "The liberty flag", {'l', "liberty"});
+    args::ValueFlag<string> libertyCache(
+        parser, "liberty cache", "The directory of parsed liberty caches", {"liberty_cache"});
+    args::ValueFlag<string> columns(
+        parser, "columns", "The columns to write, comma separated or in a file", {"columns"});
+    args::Flag columnar(parser, "columnar", "Write the tables in a columnar binary format", {"columnar"});
+    args::Flag graphTables(
+        parser, "graph tables", "Also write the candidate graph as node and edge tables", {"graph_tables"});
+    args::ValueFlag<string> imageDir(
+        parser, "image dir", "The directory of scratch files backing the die image", {"image_dir"});
+    args::ValueFlag<unsigned> imageShards(
+        parser, "image shards", "The number of subdirectories the via patches are spread over", {"image_shards"});
     args::ValueFlag<string> metal(parser, "metal", "The metal flag", {'m', "metal"});
     args::ValueFlag<string> net(parser, "net", "The net detail flag", {'n', "net_detail"});
     args::ValueFlag<string> numCands(parser, "num cands", "The number of candidates flag", {'d', "num_cands"});
     args::ValueFlag<string> output(parser, "output", "The output flag", {'o', "output_csv"});
+    args::ValueFlag<string> serve(
+        parser, "serve", "Serve extraction jobs on this UNIX socket with the libraries loaded", {"serve"});
     args::ValueFlag<string> tech(parser, "tech", "The tech lef flag", {'c', "tech_lef"});
     args::ValueFlag<string> timePath(parser, "time path", "The time path flag", {'p', "time_path"});
     args::ValueFlag<string> timeUnconstrain(
         parser, "time unconstrain", "The time unconstrain flag", {'u', "time_unconstrain"});
+    args::ValueFlag<unsigned> workers(parser, "workers", "The number of jobs the server runs at a time", {"workers"});
 
     try {
         parser.ParseCLI(argc, argv);
@@ -57,6 +72,24 @@ int main(int argc, char** argv) {
     if (liberty) {
         io::IOModule::Liberty = args::get(liberty);
     }
+    if (libertyCache) {
+        io::IOModule::LibertyCache = args::get(libertyCache);
+    }
+    if (columns && !io::IOModule::selectColumns(args::get(columns))) {
+        return 1;
+    }
+    if (columnar) {
+        io::IOModule::Columnar = true;
+    }
+    if (graphTables) {
+        io::IOModule::GraphTables = true;
+    }
+    if (imageDir) {
+        io::IOModule::ImageDir = args::get(imageDir);
+    }
+    if (imageShards) {
+        io::IOModule::ImageShards = args::get(imageShards);
+    }
     if (metal) { db::DBModule::Metal = atoi(args::get(metal).c_str()); }
     if (net) {
         io::IOModule::NetDetail = args::get(net);
@@ -71,6 +104,12 @@ int main(int argc, char** argv) {
     if (timePath) io::IOModule::TimePath = args::get(timePath);
     if (timeUnconstrain) io::IOModule::TimeUnconstrain = args::get(timeUnconstrain);
 
+    if (serve) {
+        //  each job brings its own design
+        io::IOModule::DefCell.clear();
+        return api::serve(args::get(serve), workers ? args::get(workers) : 1) ? 0 : 1;
+    }
+
     io::IOModule::load();
     db::DBModule::setup();
 
@@ -12,9 +12,87 @@ void STALibraryLUT::clear() {
     indexX.clear();
     indexY.clear();
     indexZ.clear();
+    nx = ny = nz = 0;
     values.clear();
 }
 
+void STALibraryLUT::set(const unsigned x, const unsigned y, const unsigned z, vector<double>&& table) {
+    nx = x;
+    ny = y;
+    nz = z;
+    values = move(table);
+    minX = indexX.empty() ? 0.0 : indexX.front();
+    maxX = indexX.empty() ? 0.0 : indexX.back();
+    minY = indexY.empty() ? 0.0 : indexY.front();
+    maxY = indexY.empty() ? 0.0 : indexY.back();
+    minZ = indexZ.empty() ? 0.0 : indexZ.front();
+    maxZ = indexZ.empty() ? 0.0 : indexZ.back();
+}
+
+namespace {
+//  the segment [index[i], index[i + 1]] of x, with the first and last segments extended to infinity,
+//  and the position t of x in it; branch-free so that batched lookups vectorize
+inline void locate(const double* index, const unsigned n, const double x, unsigned& i, double& t) {
+    i = 0;
+    t = 0.0;
+    if (n < 2) return;
+    for (unsigned k = 1; k + 1 < n; ++k) i += x >= index[k];
+    t = (x - index[i]) / (index[i + 1] - index[i]);
+}
+
+//  v points at the entry (i, j, k), d* are the strides to the next entry or 0 on a single-entry axis
+inline double interpolate(const double* v,
+                          const unsigned dx,
+                          const unsigned dy,
+                          const unsigned dz,
+                          const double tx,
+                          const double ty,
+                          const double tz) {
+    const double v00 = v[0] + (v[dz] - v[0]) * tz;
+    const double v01 = v[dy] + (v[dy + dz] - v[dy]) * tz;
+    const double v10 = v[dx] + (v[dx + dz] - v[dx]) * tz;
+    const double v11 = v[dx + dy] + (v[dx + dy + dz] - v[dx + dy]) * tz;
+    const double v0 = v00 + (v01 - v00) * ty;
+    const double v1 = v10 + (v11 - v10) * ty;
+    return v0 + (v1 - v0) * tx;
+}
+}  // namespace
+
+double STALibraryLUT::get(const double x, const double y, const double z) const {
+    if (isScalar || values.empty()) return value;
+    unsigned i, j, k;
+    double tx, ty, tz;
+    locate(indexX.data(), nx, x, i, tx);
+    locate(indexY.data(), ny, y, j, ty);
+    locate(indexZ.data(), nz, z, k, tz);
+    return interpolate(
+        &values[(i * ny + j) * nz + k], nx > 1 ? ny * nz : 0, ny > 1 ? nz : 0, nz > 1 ? 1 : 0, tx, ty, tz);
+}
+
+void STALibraryLUT::get(const size_t n, const double* xs, const double* ys, double* out) const {
+    if (isScalar || values.empty()) {
+        fill(out, out + n, value);
+        return;
+    }
+    unsigned k;
+    double tz;
+    locate(indexZ.data(), nz, 0.0, k, tz);
+    const double* ix = indexX.data();
+    const double* iy = indexY.data();
+    const double* v = values.data() + k;
+    const unsigned dx = nx > 1 ? ny * nz : 0;
+    const unsigned dy = ny > 1 ? nz : 0;
+    const unsigned dz = nz > 1 ? 1 : 0;
+#pragma omp simd
+    for (size_t q = 0; q < n; ++q) {
+        unsigned i, j;
+        double tx, ty;
+        locate(ix, nx, xs[q], i, tx);
+        locate(iy, ny, ys[q], j, ty);
+        out[q] = interpolate(v + (i * ny + j) * nz, dx, dy, dz, tx, ty, tz);
+    }
+}
+
 void STALibraryLUT::print() {
     cout << "index_1 : ";
     copy(indexX.begin(), indexX.end(), experimental::make_ostream_joiner(cout, " "));
@@ -28,9 +106,10 @@ void STALibraryLUT::print() {
     copy(indexZ.begin(), indexZ.end(), experimental::make_ostream_joiner(cout, " "));
     cout << endl;
 
-    for (const vector<vector<double>>& value : values) {
-        for (const vector<double>& val : value) {
-            copy(val.begin(), val.end(), experimental::make_ostream_joiner(cout, " "));
+    for (unsigned x = 0; x != nx; ++x) {
+        for (unsigned y = 0; y != ny; ++y) {
+            const double* val = &values[(x * ny + y) * nz];
+            copy(val, val + nz, experimental::make_ostream_joiner(cout, " "));
             cout << endl;
         }
         cout << endl;
@@ -40,33 +119,52 @@ void STALibraryLUT::print() {
 double STALibraryOPin::default_max_capacitance = 0;
 double STALibraryIPin::default_capacitance = 0;
 
+namespace {
+inline bool arcLess(const STALibraryArc& lhs, const STALibraryArc& rhs) {
+    return lhs.ipin < rhs.ipin || (lhs.ipin == rhs.ipin && lhs.opin < rhs.opin);
+}
+}  // namespace
+
+int STALibraryCell::timingArc(const unsigned ipin, const unsigned opin) const {
+    const STALibraryArc key{ipin, opin, 0};
+    vector<STALibraryArc>::const_iterator ai = lower_bound(timingArcs.begin(), timingArcs.end(), key, arcLess);
+    return ai != timingArcs.end() && !arcLess(key, *ai) ? ai->timing : -1;
+}
+
 void STALibrary::postLoad() {
-    for (STALibraryCell& libcell : cells) {
-        unsigned nOPins = libcell.opins.size();
-        unsigned nIPins = libcell.ipins.size();
-        libcell.timingArcs.resize(nIPins, vector<int>(nOPins, -1));
-        for (unsigned op = 0; op != nOPins; ++op) {
-            unsigned nTimings = libcell.opins[op].timings.size();
-            for (unsigned t = 0; t != nTimings; ++t) {
-                STALibraryTiming& timing = libcell.opins[op].timings[t];
-                bool ipFound = false;
-                for (unsigned ip = 0; ip != nIPins; ++ip) {
-                    if (libcell.ipins[ip].name() == timing.relatedPinName) {
-                        timing.relatedPin = ip;
-                        if (libcell.timingArcs[ip][op] != -1) {
-                            //  cerr << "timing arc duplicated!" << endl;
-                        }
-                        libcell.timingArcs[ip][op] = t;
-                        ipFound = true;
-                        break;
-                    }
-                }
-                if (!ipFound) {
-                    cout << "related pin (" << timing.relatedPinName << ") not found for pin "
-                         << libcell.opins[op].name() << endl;
+#pragma omp parallel for schedule(dynamic)
+    for (unsigned c = 0; c < cells.size(); ++c) {
+        STALibraryCell& libcell = cells[c];
+        unordered_map<string_view, unsigned> ipinIdx;
+        ipinIdx.reserve(libcell.ipins.size());
+        for (unsigned ip = 0; ip != libcell.ipins.size(); ++ip) ipinIdx.emplace(libcell.ipins[ip].name(), ip);
+
+        libcell.timingArcs.clear();
+        for (unsigned op = 0; op != libcell.opins.size(); ++op) {
+            vector<STALibraryTiming>& timings = libcell.opins[op].timings;
+            for (unsigned t = 0; t != timings.size(); ++t) {
+                STALibraryTiming& timing = timings[t];
+                unordered_map<string_view, unsigned>::const_iterator ii = ipinIdx.find(timing.relatedPinName);
+                if (ii == ipinIdx.end()) {
+                    printlog(LOG_WARN,
+                             "related pin (%s) not found for pin %s",
+                             timing.relatedPinName.c_str(),
+                             libcell.opins[op].name().c_str());
+                    continue;
                 }
+                timing.relatedPin = ii->second;
+                libcell.timingArcs.push_back({ii->second, op, t});
             }
         }
+        //  a duplicated arc keeps its last timing
+        stable_sort(libcell.timingArcs.begin(), libcell.timingArcs.end(), arcLess);
+        vector<STALibraryArc>::iterator last = libcell.timingArcs.begin();
+        for (vector<STALibraryArc>::iterator ai = libcell.timingArcs.begin(); ai != libcell.timingArcs.end(); ++ai) {
+            if (last != ai && (last->ipin != ai->ipin || last->opin != ai->opin)) ++last;
+            *last = *ai;
+        }
+        if (libcell.timingArcs.size()) libcell.timingArcs.erase(last + 1, libcell.timingArcs.end());
+        libcell.timingArcs.shrink_to_fit();
     }
 }
 
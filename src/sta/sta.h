@@ -12,23 +12,34 @@ namespace sta {
 class STALibraryLUT {
 public:
     bool isScalar = false;
-    double value;
+    double value = 0.0;
     vector<double> indexX;
     vector<double> indexY;
     vector<double> indexZ;
-    double minX;
-    double maxX;
-    double minY;
-    double maxY;
-    double minZ;
-    double maxZ;
-    vector<vector<vector<double>>> values;
+    double minX = 0.0;
+    double maxX = 0.0;
+    double minY = 0.0;
+    double maxY = 0.0;
+    double minZ = 0.0;
+    double maxZ = 0.0;
+    //  nx * ny * nz table, flattened so that the entry (x, y, z) is values[(x * ny + y) * nz + z]
+    unsigned nx = 0;
+    unsigned ny = 0;
+    unsigned nz = 0;
+    vector<double> values;
 
     STALibraryLUT() {}
     STALibraryLUT(double scalar) : isScalar(true), value(scalar) {}
 
     void clear();
-    //  double get(double x = 0, double y = 0, double z = 0);
+    //  take the table and cache the ranges of the indices
+    void set(const unsigned x, const unsigned y, const unsigned z, vector<double>&& table);
+    double at(const unsigned x, const unsigned y, const unsigned z) const { return values[(x * ny + y) * nz + z]; }
+
+    //  linear interpolation on every axis of more than one entry, extrapolating beyond the first and last index
+    double get(const double x = 0, const double y = 0, const double z = 0) const;
+    //  get(xs[i], ys[i]) for i < n, vectorized over the queries
+    void get(const size_t n, const double* xs, const double* ys, double* out) const;
     void print();
 };
 
@@ -38,7 +49,8 @@ public:
     STALibraryLUT delayFall;
     STALibraryLUT slewRise;
     STALibraryLUT slewFall;
-    int relatedPin;
+    //  index of the related pin in STALibraryCell::ipins, resolved by STALibrary::postLoad
+    int relatedPin = -1;
     string relatedPinName;
     char timingSense;  //'+' / '-' / 'x'
 };
@@ -83,6 +95,13 @@ public:
     void name(const string& s) { _name = s; }
 };
 
+//  the timing from input pin `ipin` to output pin `opin` is opins[opin].timings[timing]
+struct STALibraryArc {
+    unsigned ipin;
+    unsigned opin;
+    unsigned timing;
+};
+
 class STALibraryCell {
 private:
     string _name = "";
@@ -93,7 +112,8 @@ public:
     // map from FCell pin index to STALibraryCell index
     vector<STALibraryOPin> opins;
     vector<STALibraryIPin> ipins;
-    vector<vector<int>> timingArcs;
+    //  sparse, sorted by (ipin, opin)
+    vector<STALibraryArc> timingArcs;
 
     STALibraryCell(const string& name = "", const unsigned drive_strength = 0) : _name(name), _drive_strength(drive_strength) {}
 
@@ -105,11 +125,16 @@ public:
 
     void addOPin(const string& s) { opins.emplace_back(s); }
     void addIPin(const string& s) { ipins.emplace_back(s); }
+
+    //  index into opins[opin].timings, -1 if there is no arc
+    int timingArc(const unsigned ipin, const unsigned opin) const;
 };
 
 class STALibrary {
 public:
     string name;
+    //  pF per capacitance unit of the library
+    double capacitanceUnit = 1.0;
     vector<STALibraryCell> cells;
 
     void postLoad();
@@ -0,0 +1,288 @@
+#include <array>
+#include <numeric>
+
+#include "sta.h"
+using namespace sta;
+
+#include "../db/db.h"
+#include "../io/io.h"
+using namespace db;
+
+namespace {
+//  views of PinSTA: late rise, late fall, early rise, early fall
+constexpr unsigned Rise = 0;
+constexpr unsigned Fall = 1;
+constexpr unsigned Early = 2;
+constexpr double INFTY = numeric_limits<double>::infinity();
+
+struct TimingEdge {
+    unsigned from;
+    unsigned to;
+    //  nullptr for the net arc from a driver to one of its sinks
+    const STALibraryTiming* timing;
+};
+
+//  output transitions of a cell arc for an input transition
+inline bool isUnate(const STALibraryTiming& timing, const unsigned iRF, const unsigned oRF) {
+    switch (timing.timingSense) {
+        case '+':
+            return iRF == oRF;
+        case '-':
+            return iRF != oRF;
+        default:
+            return true;
+    }
+}
+
+inline const STALibraryLUT& delayLUT(const STALibraryTiming& timing, const unsigned oRF) {
+    return oRF == Rise ? timing.delayRise : timing.delayFall;
+}
+
+inline const STALibraryLUT& slewLUT(const STALibraryTiming& timing, const unsigned oRF) {
+    return oRF == Rise ? timing.slewRise : timing.slewFall;
+}
+}  // namespace
+
+void Database::setupSTA() {
+    //  timing nodes are the signal pins of cells and the IO pins
+    vector<Pin*> pins;
+    unordered_map<const Pin*, unsigned> pinIdx;
+    vector<double> pinCaps;
+    for (const Cell* cell : cells) {
+        const CellType* ctype = cell->ctype();
+        const STALibraryCell* libcell = ctype->libcell() < 0 ? nullptr : &rlib.cells[ctype->libcell()];
+        for (Pin* pin : cell->pins()) {
+            const Use::UseEnum use = pin->type->use();
+            if (use == Use::UseEnum::Power || use == Use::UseEnum::Ground) continue;
+            double cap = 0.0;
+            if (libcell && pin->isSink()) {
+                for (const STALibraryIPin& ipin : libcell->ipins) {
+                    if (ipin.name() == pin->name()) {
+                        cap = ipin.capacitance;
+                        break;
+                    }
+                }
+            }
+            pinIdx.emplace(pin, pins.size());
+            pins.push_back(pin);
+            pinCaps.push_back(cap);
+        }
+    }
+    for (IOPin* iopin : iopins) {
+        pinIdx.emplace(iopin->pin, pins.size());
+        pins.push_back(iopin->pin);
+        pinCaps.push_back(0.0);
+    }
+    const unsigned nPins = pins.size();
+
+    //  the load of a driver is the total capacitance of its split nets, extracted or reported,
+    //  and the input capacitance of its sinks when there is none
+    unordered_map<const Net*, double> splitNetCaps;
+    for (const SplitNet* splitNet : splitNets) splitNetCaps[splitNet->parent()] += splitNet->totalCap();
+
+    vector<TimingEdge> edges;
+    vector<double> loads(nPins, 0.0);
+    for (Net* net : nets) {
+        const Pin* driver = net->iPin();
+        if (!driver) continue;
+        unordered_map<const Pin*, unsigned>::const_iterator di = pinIdx.find(driver);
+        if (di == pinIdx.end()) continue;
+        double load = 0.0;
+        for (const Pin* pin : net->pins) {
+            if (!pin->isSink()) continue;
+            unordered_map<const Pin*, unsigned>::const_iterator si = pinIdx.find(pin);
+            if (si == pinIdx.end()) continue;
+            edges.push_back({di->second, si->second, nullptr});
+            load += pinCaps[si->second];
+        }
+        unordered_map<const Net*, double>::const_iterator ci = splitNetCaps.find(net);
+        loads[di->second] = ci != splitNetCaps.end() && ci->second > 0 ? ci->second : load;
+    }
+    for (const Cell* cell : cells) {
+        if (cell->ctype()->libcell() < 0) continue;
+        const STALibraryCell& libcell = rlib.cells[cell->ctype()->libcell()];
+        for (const STALibraryArc& arc : libcell.timingArcs) {
+            const STALibraryOPin& opin = libcell.opins[arc.opin];
+            const STALibraryIPin& ipin = libcell.ipins[arc.ipin];
+            unordered_map<const Pin*, unsigned>::const_iterator fi = pinIdx.find(cell->pin(ipin.name()));
+            unordered_map<const Pin*, unsigned>::const_iterator ti = pinIdx.find(cell->pin(opin.name()));
+            if (fi == pinIdx.end() || ti == pinIdx.end()) continue;
+            edges.push_back({fi->second, ti->second, &opin.timings[arc.timing]});
+        }
+    }
+
+    //  fanin and fanout lists in compressed rows
+    vector<unsigned> faninBegin(nPins + 1, 0);
+    vector<unsigned> fanoutBegin(nPins + 1, 0);
+    for (const TimingEdge& edge : edges) {
+        ++faninBegin[edge.to + 1];
+        ++fanoutBegin[edge.from + 1];
+    }
+    partial_sum(faninBegin.begin(), faninBegin.end(), faninBegin.begin());
+    partial_sum(fanoutBegin.begin(), fanoutBegin.end(), fanoutBegin.begin());
+    vector<unsigned> fanins(edges.size());
+    vector<unsigned> fanouts(edges.size());
+    {
+        vector<unsigned> faninPos(faninBegin.begin(), faninBegin.end() - 1);
+        vector<unsigned> fanoutPos(fanoutBegin.begin(), fanoutBegin.end() - 1);
+        for (unsigned e = 0; e != edges.size(); ++e) {
+            fanins[faninPos[edges[e].to]++] = e;
+            fanouts[fanoutPos[edges[e].from]++] = e;
+        }
+    }
+
+    //  levelize, pins on combinational loops are never released
+    vector<vector<unsigned>> levels;
+    {
+        vector<unsigned> nFanins(nPins);
+        vector<unsigned> frontier;
+        for (unsigned p = 0; p != nPins; ++p) {
+            nFanins[p] = faninBegin[p + 1] - faninBegin[p];
+            if (!nFanins[p]) frontier.push_back(p);
+        }
+        unsigned nLevelized = 0;
+        while (frontier.size()) {
+            nLevelized += frontier.size();
+            vector<unsigned> next;
+            for (const unsigned p : frontier) {
+                for (unsigned i = fanoutBegin[p]; i != fanoutBegin[p + 1]; ++i) {
+                    const unsigned to = edges[fanouts[i]].to;
+                    if (!--nFanins[to]) next.push_back(to);
+                }
+            }
+            levels.push_back(move(frontier));
+            frontier = move(next);
+        }
+        if (nLevelized != nPins) {
+            printlog(LOG_WARN, "%u pins on combinational loops are not timed", nPins - nLevelized);
+        }
+    }
+
+    vector<array<double, 4>> aat(nPins, {-INFTY, -INFTY, INFTY, INFTY});
+    vector<array<double, 4>> rat(nPins, {INFTY, INFTY, -INFTY, -INFTY});
+    vector<array<double, 4>> slew(nPins, {0.0, 0.0, 0.0, 0.0});
+    vector<double> delays(nPins, 0.0);
+    vector<char> timed(nPins, false);
+
+    //  propagate arrival times and slews forward, all pins of a level are independent
+    for (const vector<unsigned>& level : levels) {
+#pragma omp parallel for
+        for (unsigned l = 0; l < level.size(); ++l) {
+            const unsigned p = level[l];
+            timed[p] = true;
+            if (faninBegin[p] == faninBegin[p + 1]) {
+                aat[p] = {0.0, 0.0, 0.0, 0.0};
+                continue;
+            }
+            slew[p] = {0.0, 0.0, INFTY, INFTY};
+            for (unsigned i = faninBegin[p]; i != faninBegin[p + 1]; ++i) {
+                const TimingEdge& edge = edges[fanins[i]];
+                const unsigned q = edge.from;
+                if (!edge.timing) {
+                    for (unsigned v = 0; v != 4; ++v) {
+                        const bool late = v < Early;
+                        aat[p][v] = late ? max(aat[p][v], aat[q][v]) : min(aat[p][v], aat[q][v]);
+                        slew[p][v] = late ? max(slew[p][v], slew[q][v]) : min(slew[p][v], slew[q][v]);
+                    }
+                    continue;
+                }
+                for (unsigned oRF = Rise; oRF <= Fall; ++oRF) {
+                    for (unsigned iRF = Rise; iRF <= Fall; ++iRF) {
+                        if (!isUnate(*edge.timing, iRF, oRF)) continue;
+                        for (unsigned mode = 0; mode <= Early; mode += Early) {
+                            const double s = slew[q][mode + iRF];
+                            const double d = delayLUT(*edge.timing, oRF).get(s, loads[p]);
+                            const double t = slewLUT(*edge.timing, oRF).get(s, loads[p]);
+                            double& a = aat[p][mode + oRF];
+                            double& o = slew[p][mode + oRF];
+                            if (mode == Early) {
+                                a = min(a, aat[q][mode + iRF] + d);
+                                o = min(o, t);
+                            } else {
+                                a = max(a, aat[q][mode + iRF] + d);
+                                o = max(o, t);
+                                delays[p] = max(delays[p], d);
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    //  without timing constraints, the latest arrival at any endpoint is required everywhere for setup,
+    //  and 0 for hold
+    double period = 0.0;
+    for (unsigned p = 0; p != nPins; ++p) {
+        if (timed[p] && fanoutBegin[p] == fanoutBegin[p + 1]) period = max({period, aat[p][Rise], aat[p][Fall]});
+    }
+
+    //  propagate required times backward
+    for (vector<vector<unsigned>>::const_reverse_iterator li = levels.rbegin(); li != levels.rend(); ++li) {
+        const vector<unsigned>& level = *li;
+#pragma omp parallel for
+        for (unsigned l = 0; l < level.size(); ++l) {
+            const unsigned p = level[l];
+            if (fanoutBegin[p] == fanoutBegin[p + 1]) {
+                rat[p] = {period, period, 0.0, 0.0};
+                continue;
+            }
+            for (unsigned i = fanoutBegin[p]; i != fanoutBegin[p + 1]; ++i) {
+                const TimingEdge& edge = edges[fanouts[i]];
+                const unsigned q = edge.to;
+                if (!timed[q]) continue;
+                if (!edge.timing) {
+                    for (unsigned v = 0; v != 4; ++v) {
+                        rat[p][v] = v < Early ? min(rat[p][v], rat[q][v]) : max(rat[p][v], rat[q][v]);
+                    }
+                    continue;
+                }
+                for (unsigned iRF = Rise; iRF <= Fall; ++iRF) {
+                    for (unsigned oRF = Rise; oRF <= Fall; ++oRF) {
+                        if (!isUnate(*edge.timing, iRF, oRF)) continue;
+                        for (unsigned mode = 0; mode <= Early; mode += Early) {
+                            const double d = delayLUT(*edge.timing, oRF).get(slew[p][mode + iRF], loads[q]);
+                            double& r = rat[p][mode + iRF];
+                            r = mode == Early ? max(r, rat[q][mode + oRF] - d) : min(r, rat[q][mode + oRF] - d);
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    //  annotate the pins, the timing reports take precedence when they are given
+    const bool annotate = io::IOModule::TimePath.empty() && io::IOModule::TimeUnconstrain.empty();
+    staInfos.assign(nPins, PinSTA());
+    for (unsigned p = 0; p != nPins; ++p) {
+        Pin* pin = pins[p];
+        PinSTA& info = staInfos[p];
+        pin->staInfo = &info;
+        if (!timed[p]) continue;
+        if (faninBegin[p] == faninBegin[p + 1]) {
+            info.type = 'b';
+        } else if (fanoutBegin[p] == fanoutBegin[p + 1]) {
+            info.type = 'e';
+        } else {
+            info.type = 'i';
+        }
+        info.capacitance = pin->isSource() ? loads[p] : pinCaps[p];
+        for (unsigned v = 0; v != 4; ++v) {
+            info.aat[v] = aat[p][v];
+            info.rat[v] = rat[p][v];
+            info.slack[v] = v < Early ? rat[p][v] - aat[p][v] : aat[p][v] - rat[p][v];
+        }
+        if (annotate && pin->splitNet()) {
+            pin->delay(delays[p]);
+            pin->arrive(max(aat[p][Rise], aat[p][Fall]));
+            pin->require(min(rat[p][Rise], rat[p][Fall]));
+        }
+    }
+
+    printlog(LOG_INFO,
+             "STA: %u pins %lu arcs %lu levels, latest arrival %f",
+             nPins,
+             edges.size(),
+             levels.size(),
+             period);
+}